@@ -17,6 +17,7 @@
 #include <Primrose.h>
 #define __need_size_t
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <unistd.h>
 
@@ -50,7 +51,7 @@
  * new code is committed.
  * @since v0.0.0.12
  */
-#define AGERATUM_TWEAK_VERSION 36
+#define AGERATUM_TWEAK_VERSION 48
 
 /**
  * @def AGERATUM_BASE_DIRECTORY
@@ -97,6 +98,46 @@
  */
 #define AGERATUM_MAX_PATH_LENGTH 128
 
+// Allow the user/application to define their own checksum chunk size.
+#ifndef AGERATUM_CHECKSUM_CHUNK_SIZE
+/**
+ * @def AGERATUM_CHECKSUM_CHUNK_SIZE
+ * @brief The size in bytes of each chunk read when checksumming a file. Each
+ * chunk is hashed right after it's read, while it's still in cache, so this
+ * should stay comfortably below the size of the L2 cache.
+ * @since v0.0.0.37
+ */
+#define AGERATUM_CHECKSUM_CHUNK_SIZE 65536
+#endif
+
+/**
+ * @def AGERATUM_MAX_VERIFY_THREADS
+ * @brief The maximum amount of threads @ref ageratum_verifyFiles will spread
+ * its work across, regardless of how many processors are online.
+ * @since v0.0.0.37
+ */
+#define AGERATUM_MAX_VERIFY_THREADS 64
+
+// Allow the user/application to define their own profile capacity.
+#ifndef AGERATUM_PROFILE_CAPACITY
+/**
+ * @def AGERATUM_PROFILE_CAPACITY
+ * @brief The maximum amount of distinct files a single prefetch profile can
+ * record, plus one. Loads past this limit, or past an average of 30 bytes of
+ * basename per file, are simply not recorded. This must be a power of two.
+ * @since v0.0.0.38
+ */
+#define AGERATUM_PROFILE_CAPACITY 4096
+#endif
+
+/**
+ * @def AGERATUM_YAML_MAX_DEPTH
+ * @brief The maximum depth to which YAML collections may be nested. This
+ * bounds the recursion of @ref ageratum_parseYAML.
+ * @since v0.0.0.39
+ */
+#define AGERATUM_YAML_MAX_DEPTH 64
+
 /**
  * @enum ageratum_permissions
  * @brief The various permissions that a file may be opened under. This is not a
@@ -204,6 +245,29 @@ typedef enum ageratum_type
      * @since v0.0.0.14
      */
     AGERATUM_SYSTEM,
+    /**
+     * @var ageratum_type AGERATUM_PROFILE
+     * @brief A prefetch profile, recorded by @ref ageratum_startProfile and
+     * replayed by @ref ageratum_replayProfile. It comes with the extension
+     * ".profile".
+     * @since v0.0.0.38
+     */
+    AGERATUM_PROFILE,
+    /**
+     * @var ageratum_type AGERATUM_YAML
+     * @brief A YAML file. Once loaded, this can be handed to the @ref
+     * ageratum_parseYAML function. It comes with the extension ".yaml".
+     * @since v0.0.0.39
+     */
+    AGERATUM_YAML,
+    /**
+     * @var ageratum_type AGERATUM_MANIFEST
+     * @brief A checksum manifest, written by @ref ageratum_writeManifest and
+     * loaded by @ref ageratum_loadManifest. It comes with the extension
+     * ".manifest".
+     * @since v0.0.0.40
+     */
+    AGERATUM_MANIFEST,
 } ageratum_type_t;
 
 /**
@@ -211,7 +275,7 @@ typedef enum ageratum_type
  * @brief The count of recognized filetypes by the library.
  * @since v0.0.0.18
  */
-#define AGERATUM_TYPE_COUNT 6
+#define AGERATUM_TYPE_COUNT 9
 
 /**
  * @struct ageratum_file Ageratum.h "Ageratum.h"
@@ -246,6 +310,21 @@ typedef struct ageratum_file
      * @since v0.0.0.1
      */
     size_t size;
+    /**
+     * @property checksum
+     * @brief The CRC32C checksum of the file's contents. This is only read or
+     * written when the file's @c verify property is set. Checksums are kept
+     * between runs via @ref ageratum_writeManifest.
+     * @since v0.0.0.37
+     */
+    uint32_t checksum;
+    /**
+     * @property verify
+     * @brief Whether or not the file's contents are checksummed. When set,
+     * @ref ageratum_loadFile checks against the file's @c checksum.
+     * @since v0.0.0.37
+     */
+    bool verify;
 } ageratum_file_t;
 
 /**
@@ -307,6 +386,10 @@ static inline bool ageratum_closeFile(const ageratum_file_t *const file)
  * @remark This function does not add a terminating NUL character to the loaded
  * bytes.
  *
+ * @remark If the file's @c verify property is set, the contents are read in
+ * chunks of @ref AGERATUM_CHECKSUM_CHUNK_SIZE and checksummed as they arrive,
+ * and the load fails should the result not match the file's @c checksum.
+ *
  * @param[in] file The file structure to be operated on.
  * @param[out] contents An array of bytes in which the file's contents will be
  * inserted. This must be large enough to store the file's entire contents.
@@ -339,6 +422,28 @@ bool ageratum_loadFile(const ageratum_file_t *const file, char *contents);
 bool ageratum_writeFile(const ageratum_file_t *const file,
                         const char *const contents);
 
+/**
+ * @fn bool ageratum_writeChecksummedFile(ageratum_file_t *file, const char
+ * *const contents)
+ * @brief Write the given contents to the given file as @ref ageratum_writeFile
+ * does, recording their checksum on the way.
+ * @since v0.0.0.40
+ *
+ * @param[in, out] file The file structure to be operated on. The file's @c
+ * checksum property is set, and its @c verify property enabled, by this
+ * function.
+ * @param[in] contents An array of bytes which will be written to the file.
+ * This must be the same length or longer than described in the provided file
+ * structure's @c size property.
+ *
+ * @return A boolean value representing whether or not the file was written to
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value. This function typically fails because of IO errors.
+ */
+[[gnu::nonnull(1, 2)]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_writeChecksummedFile(ageratum_file_t *file,
+                                   const char *const contents);
+
 /**
  * @fn bool ageratum_getFileSize(ageratum_file_t *file)
  * @brief Get the size of the given file in bytes. The given file's handle must
@@ -356,6 +461,197 @@ bool ageratum_writeFile(const ageratum_file_t *const file,
 [[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
 bool ageratum_getFileSize(ageratum_file_t *file);
 
+/**
+ * @fn uint32_t ageratum_crc32c(uint32_t crc, const void *const data, size_t
+ * size)
+ * @brief Calculate the CRC32C (Castagnoli) checksum of the given bytes. This
+ * uses the SSE4.2 @c crc32 instruction when the processor supports it, and a
+ * slicing-by-8 table otherwise.
+ * @since v0.0.0.37
+ *
+ * @param[in] crc The checksum of any preceding bytes, or 0 to start anew.
+ * @param[in] data The bytes to be checksummed.
+ * @param[in] size The count of bytes to be checksummed.
+ *
+ * @return The checksum of the preceding bytes followed by the given ones.
+ */
+[[gnu::nonnull(2)]] [[gnu::hot]] [[gnu::pure]]
+uint32_t ageratum_crc32c(uint32_t crc, const void *const data, size_t size);
+
+/**
+ * @fn bool ageratum_checksumFile(ageratum_file_t *file)
+ * @brief Calculate the checksum of the given file's contents on disk, for use
+ * when baking assets. The given file structure must have a valid file pointer
+ * positioned at its beginning, and its size must have been polled via @ref
+ * ageratum_getFileSize.
+ * @since v0.0.0.37
+ *
+ * @param[in, out] file The file structure to be operated on. The file's @c
+ * checksum property is set, and its @c verify property enabled, by this
+ * function.
+ *
+ * @return A boolean value representing whether or not the file was
+ * checksummed successfully. On failure, a message will be posted to @c stderr
+ * alongside the current @c ERRNO value. This function typically fails because
+ * of IO errors.
+ */
+[[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_checksumFile(ageratum_file_t *file);
+
+/**
+ * @fn bool ageratum_verifyFiles(const ageratum_file_t *const files, size_t
+ * count, bool *results)
+ * @brief Verify the on-disk contents of many files against their recorded
+ * checksums, spread across every online processor. The given files must have a
+ * valid basename and type; they're opened and closed internally. Files whose
+ * @c verify property is unset are skipped, and files with a nonzero @c size
+ * must also match it.
+ * @since v0.0.0.37
+ *
+ * @param[in] files The file structures to be verified.
+ * @param[in] count The count of files provided.
+ * @param[out] results An optional array of @c count booleans in which each
+ * file's individual result is stored. This may be @c nullptr.
+ *
+ * @return A boolean value representing whether or not every file was verified
+ * successfully. On failure, a message will be posted to @c stderr for each
+ * missing, unreadable, or corrupted file.
+ */
+[[gnu::nonnull(1)]] [[gnu::cold]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_verifyFiles(const ageratum_file_t *const files, size_t count,
+                          bool *results);
+
+/**
+ * @fn bool ageratum_writeManifest(const ageratum_file_t *const manifest, const
+ * ageratum_file_t *const files, size_t count)
+ * @brief Record the type, basename, size, and checksum of every given file
+ * into a manifest, replacing any previous contents. The manifest is written
+ * to a temporary file first and renamed into place, so a reader never sees it
+ * half-written. Files whose @c verify property is unset are skipped.
+ * @since v0.0.0.40
+ *
+ * @param[in] manifest The manifest to write. This must have a valid basename,
+ * and its type must be @ref AGERATUM_MANIFEST.
+ * @param[in] files The file structures to be recorded.
+ * @param[in] count The count of files provided.
+ *
+ * @return A boolean value representing whether or not the manifest was
+ * written successfully. On failure, a message will be posted to @c stderr
+ * alongside the current @c ERRNO value. This function typically fails because
+ * of IO errors.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::cold]]
+[[nodiscard("Expression result unchecked.")]]
+bool ageratum_writeManifest(const ageratum_file_t *const manifest,
+                            const ageratum_file_t *const files, size_t count);
+
+/**
+ * @fn bool ageratum_loadManifest(const ageratum_file_t *const manifest,
+ * ageratum_file_t *files, char (*names)[AGERATUM_MAX_PATH_LENGTH], size_t
+ * *count)
+ * @brief Load every entry of a manifest written by @ref
+ * ageratum_writeManifest. The loaded file structures are ready to be handed
+ * to @ref ageratum_verifyFiles or @ref ageratum_applyManifest.
+ * @since v0.0.0.40
+ *
+ * @param[in] manifest The manifest to load. This must have a valid basename,
+ * and its type must be @ref AGERATUM_MANIFEST.
+ * @param[out] files The file structures to load into. Each has its basename,
+ * type, size, and checksum set, and its @c verify property enabled. They are
+ * left sorted by type and then basename, for @ref ageratum_applyManifest.
+ * @param[out] names The storage for the loaded basenames, one per file.
+ * @param[in, out] count The count of files and names provided, which is
+ * replaced by the count of files loaded.
+ *
+ * @return A boolean value representing whether or not the manifest was loaded
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value. This function typically fails because the manifest
+ * does not exist, is malformed, or holds more entries than were provided.
+ */
+[[gnu::nonnull(1, 2, 3, 4)]] [[gnu::cold]]
+[[nodiscard("Expression result unchecked.")]]
+bool ageratum_loadManifest(const ageratum_file_t *const manifest,
+                           ageratum_file_t *files,
+                           char (*names)[AGERATUM_MAX_PATH_LENGTH],
+                           size_t *count);
+
+/**
+ * @fn bool ageratum_applyManifest(const ageratum_file_t *const entries, size_t
+ * count, ageratum_file_t *file)
+ * @brief Copy the recorded checksum of the given file out of a loaded
+ * manifest, so that @ref ageratum_loadFile verifies it.
+ * @since v0.0.0.40
+ *
+ * @param[in] entries The entries loaded via @ref ageratum_loadManifest, in
+ * the order it left them, as they are binary searched.
+ * @param[in] count The count of entries.
+ * @param[in, out] file The file structure to be operated on. If found, its @c
+ * checksum property is set and its @c verify property enabled.
+ *
+ * @return Whether or not the file was found within the manifest.
+ */
+[[gnu::nonnull(1, 3)]]
+bool ageratum_applyManifest(const ageratum_file_t *const entries, size_t count,
+                            ageratum_file_t *file);
+
+/**
+ * @fn bool ageratum_startProfile(const ageratum_file_t *const profile)
+ * @brief Begin recording the order in which files are first loaded via @ref
+ * ageratum_loadFile into the given prefetch profile. Only successful loads are
+ * recorded, and only one profile may be recorded at a time.
+ * @since v0.0.0.38
+ *
+ * @remark The profile's previous contents are kept until @ref
+ * ageratum_stopProfile replaces them, so a profile may be recorded while it's
+ * still being replayed.
+ *
+ * @param[in] profile The profile to record into. This must have a valid
+ * basename, which must stay valid until @ref ageratum_stopProfile is called,
+ * and its type must be @ref AGERATUM_PROFILE.
+ *
+ * @return A boolean value representing whether or not recording began
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value. This function typically fails because a profile is
+ * already being recorded or because of IO errors.
+ */
+[[gnu::nonnull(1)]] [[gnu::cold]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_startProfile(const ageratum_file_t *const profile);
+
+/**
+ * @fn bool ageratum_stopProfile(void)
+ * @brief Stop recording the current prefetch profile, and atomically move it
+ * over the profile's previous contents.
+ * @since v0.0.0.38
+ *
+ * @return A boolean value representing whether or not the profile was closed
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value. This function typically fails because no profile is
+ * being recorded or because of IO errors when flushing.
+ */
+[[gnu::cold]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_stopProfile(void);
+
+/**
+ * @fn bool ageratum_replayProfile(const ageratum_file_t *const profile)
+ * @brief Hint to the kernel, in recorded order, every file within the given
+ * prefetch profile, so that they're read into the page cache before they're
+ * demanded. This is done on a detached background thread, and returns once
+ * the thread has been spawned.
+ * @since v0.0.0.38
+ *
+ * @remark Files named in the profile which no longer exist are skipped.
+ *
+ * @param[in] profile The profile to replay. This must have a valid basename,
+ * and its type must be @ref AGERATUM_PROFILE.
+ *
+ * @return A boolean value representing whether or not replay began
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value. This function typically fails because the profile
+ * does not exist.
+ */
+[[gnu::nonnull(1)]] [[gnu::cold]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_replayProfile(const ageratum_file_t *const profile);
+
 /**
  * @fn bool ageratum_executeFile(const ageratum_file_t *const file, const char
  * *const *const argv, size_t argc, int *status)
@@ -424,14 +720,239 @@ static inline bool ageratum_fileExists(const ageratum_file_t *const file)
 void ageratum_splitStem(const char *const original, char *filename,
                         char *extension);
 
+/**
+ * @struct ageratum_yaml_view Ageratum.h "Ageratum.h"
+ * @brief A view into the source buffer of a YAML document. This is not NUL
+ * terminated, and is only valid for as long as the source buffer is.
+ * @since v0.0.0.39
+ */
+typedef struct ageratum_yaml_view
+{
+    /**
+     * @property data
+     * @brief The first character of the view, or @c nullptr if it's empty.
+     * @since v0.0.0.39
+     */
+    const char *data;
+    /**
+     * @property length
+     * @brief The length of the view in characters.
+     * @since v0.0.0.39
+     */
+    size_t length;
+} ageratum_yaml_view_t;
+
+/**
+ * @enum ageratum_yaml_kind
+ * @brief The various kinds of node a YAML document is made of. This is not a
+ * bitmask.
+ * @since v0.0.0.39
+ *
+ * @showenumvalues
+ */
+typedef enum ageratum_yaml_kind
+{
+    /**
+     * @var ageratum_yaml_kind AGERATUM_YAML_SCALAR
+     * @brief A scalar value. Its text is stored in the node's @c value
+     * property; an empty view is a null value. Quoted scalars are stored
+     * without their quotes, and with their escapes left as written.
+     * @since v0.0.0.39
+     */
+    AGERATUM_YAML_SCALAR,
+    /**
+     * @var ageratum_yaml_kind AGERATUM_YAML_MAP
+     * @brief A mapping. Each child node has its @c key property set.
+     * @since v0.0.0.39
+     */
+    AGERATUM_YAML_MAP,
+    /**
+     * @var ageratum_yaml_kind AGERATUM_YAML_SEQUENCE
+     * @brief A sequence.
+     * @since v0.0.0.39
+     */
+    AGERATUM_YAML_SEQUENCE,
+    /**
+     * @var ageratum_yaml_kind AGERATUM_YAML_ALIAS
+     * @brief An alias of a previously anchored node. The node's @c child
+     * property is the index of the anchored node, and its @c value property
+     * is the anchor's name.
+     * @since v0.0.0.39
+     */
+    AGERATUM_YAML_ALIAS,
+} ageratum_yaml_kind_t;
+
+/**
+ * @struct ageratum_yaml_node Ageratum.h "Ageratum.h"
+ * @brief A single node of a parsed YAML document. Nodes are stored flat, in
+ * document order, and link to one another by index; the root is always index
+ * 0, so an index of 0 anywhere else means "none".
+ * @since v0.0.0.39
+ */
+typedef struct ageratum_yaml_node
+{
+    /**
+     * @property key
+     * @brief The key of the node, if its parent is a map.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_view_t key;
+    /**
+     * @property value
+     * @brief The text of the node, if it's a scalar or alias.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_view_t value;
+    /**
+     * @property anchor
+     * @brief The name of the anchor set on the node, if any.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_view_t anchor;
+    /**
+     * @property kind
+     * @brief The kind of the node.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_kind_t kind;
+    /**
+     * @property child
+     * @brief The index of the node's first child if it's a collection, or of
+     * its target if it's an alias.
+     * @since v0.0.0.39
+     */
+    uint32_t child;
+    /**
+     * @property next
+     * @brief The index of the node's next sibling.
+     * @since v0.0.0.39
+     */
+    uint32_t next;
+    /**
+     * @property count
+     * @brief The count of the node's children if it's a collection.
+     * @since v0.0.0.39
+     */
+    uint32_t count;
+} ageratum_yaml_node_t;
+
+/**
+ * @struct ageratum_yaml_document Ageratum.h "Ageratum.h"
+ * @brief A parsed YAML document. The node storage is provided by the caller,
+ * so parsing never allocates. A document may be parsed into repeatedly, for
+ * instance whenever its file changes.
+ * @since v0.0.0.39
+ */
+typedef struct ageratum_yaml_document
+{
+    /**
+     * @property nodes
+     * @brief The caller-provided storage for the document's nodes.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_node_t *nodes;
+    /**
+     * @property capacity
+     * @brief The count of nodes the @c nodes array can hold.
+     * @since v0.0.0.39
+     */
+    uint32_t capacity;
+    /**
+     * @property count
+     * @brief The count of nodes in use. This is 0 until the document has been
+     * parsed successfully, and is otherwise that of the last successful parse.
+     * @since v0.0.0.39
+     */
+    uint32_t count;
+    /**
+     * @property checksum
+     * @brief The checksum of the source the document was last parsed from.
+     * @since v0.0.0.39
+     */
+    uint32_t checksum;
+    /**
+     * @property size
+     * @brief The size in bytes of the source the document was last parsed
+     * from.
+     * @since v0.0.0.39
+     */
+    size_t size;
+    /**
+     * @property source
+     * @brief The source buffer the document's views point into.
+     * @since v0.0.0.39
+     */
+    const char *source;
+} ageratum_yaml_document_t;
+
+/**
+ * @fn bool ageratum_parseYAML(ageratum_yaml_document_t *document, const char
+ * *const source, size_t size)
+ * @brief Parse the given YAML source into the given document. This supports a
+ * subset of YAML: a single document of block and flow maps and sequences,
+ * plain and quoted single-line scalars, anchors, and aliases. Block scalars
+ * and tags are not supported.
+ * @since v0.0.0.39
+ *
+ * @remark If the document was already parsed from identical contents, the
+ * source is not reparsed; the existing nodes are simply pointed at the new
+ * buffer. Otherwise, a reparse is made into the nodes left over after the
+ * current ones and only replaces them once it succeeds, so a capacity of
+ * twice the expected node count keeps the last good parse through any edit.
+ * Should too few nodes be left over, the reparse is made in place instead.
+ *
+ * @param[in, out] document The document to parse into. Its @c nodes and @c
+ * capacity properties must be set; all other values are managed by the
+ * library, and should be zeroed before the first parse.
+ * @param[in] source The YAML source, for instance as loaded by @ref
+ * ageratum_loadFile. This must outlive the document's use.
+ * @param[in] size The size of the source in bytes.
+ *
+ * @return A boolean value representing whether or not the document was parsed
+ * successfully. On failure, a message will be posted to @c stderr alongside the
+ * offending line, and the document is left as it was before the call, unless
+ * the reparse was made in place, in which case its @c count is 0. This
+ * function typically
+ * fails because of malformed or unsupported syntax, or because the document
+ * needs more nodes than were provided.
+ */
+[[gnu::nonnull(1, 2)]] [[nodiscard("Expression result unchecked.")]]
+bool ageratum_parseYAML(ageratum_yaml_document_t *document,
+                        const char *const source, size_t size);
+
+/**
+ * @fn uint32_t ageratum_findYAML(const ageratum_yaml_document_t *const
+ * document, uint32_t map, const char *const key)
+ * @brief Find the child of the given map node with the given key. Aliases are
+ * followed, both for the map and for the found child.
+ * @since v0.0.0.39
+ *
+ * @param[in] document The document to be searched.
+ * @param[in] map The index of the map to be searched.
+ * @param[in] key The NUL-terminated key to search for.
+ *
+ * @return The index of the found node, or 0 if the node isn't a map or has no
+ * such key.
+ */
+[[gnu::nonnull(1, 3)]] [[gnu::pure]]
+uint32_t ageratum_findYAML(const ageratum_yaml_document_t *const document,
+                           uint32_t map, const char *const key);
+
 ///////////////////////////////////////////////////////////////////////////////
 //                              IMPLEMENTATION                               //
 // ////////////////////////////////////////////////////////////////////////////
 #ifdef AGERATUM_IMPLEMENTATION
 
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 
+#ifdef __x86_64__
+#include <nmmintrin.h>
+#endif
+
 /**
  * @var const char *const ageratum_shaderSourcePath
  * @brief The path to the local shader source directory, kept separate from
@@ -461,8 +982,238 @@ static const char *const ageratum_infos[AGERATUM_TYPE_COUNT][2] = {
     [AGERATUM_SPIRV_VERTEX] = {ageratum_shaderCompiledPath, "-vert.spv"},
     [AGERATUM_SPIRV_FRAGMENT] = {ageratum_shaderCompiledPath, "-frag.spv"},
     [AGERATUM_SYSTEM] = {nullptr, nullptr},
+    [AGERATUM_PROFILE] = {nullptr, ".profile"},
+    [AGERATUM_YAML] = {nullptr, ".yaml"},
+    [AGERATUM_MANIFEST] = {nullptr, ".manifest"},
 };
 
+/**
+ * @def AGERATUM_CRC32C_POLYNOMIAL
+ * @brief The reversed Castagnoli polynomial, as used by the SSE4.2 @c crc32
+ * instruction.
+ * @since v0.0.0.37
+ */
+#define AGERATUM_CRC32C_POLYNOMIAL 0x82F63B78
+
+/**
+ * @def AGERATUM_CRC32C_STRIDE
+ * @brief The length in bytes of each of the three streams the hardware CRC32C
+ * path interleaves. This must be a power of two.
+ * @since v0.0.0.37
+ */
+#define AGERATUM_CRC32C_STRIDE 4096
+
+/**
+ * @var uint32_t ageratum_crcTable[8][256]
+ * @brief The slicing-by-8 lookup tables for the software CRC32C path.
+ * @since v0.0.0.37
+ */
+static uint32_t ageratum_crcTable[8][256];
+
+/**
+ * @var uint32_t ageratum_crcShiftTable[4][256]
+ * @brief The lookup tables used to append @ref AGERATUM_CRC32C_STRIDE zero
+ * bytes to a CRC, which is how the interleaved hardware streams are combined.
+ * @since v0.0.0.37
+ */
+static uint32_t ageratum_crcShiftTable[4][256];
+
+/**
+ * @var bool ageratum_crcHardware
+ * @brief Whether or not the processor supports the SSE4.2 @c crc32
+ * instruction.
+ * @since v0.0.0.37
+ */
+static bool ageratum_crcHardware = false;
+
+/**
+ * @fn uint32_t ageratum_gf2Multiply(const uint32_t *matrix, uint32_t vector)
+ * @brief Multiply a 32x32 matrix over GF(2) by the given vector.
+ * @since v0.0.0.37
+ *
+ * @param[in] matrix The matrix, stored as 32 columns.
+ * @param[in] vector The vector to be multiplied.
+ *
+ * @return The product.
+ */
+[[gnu::nonnull(1)]] [[gnu::pure]]
+static uint32_t ageratum_gf2Multiply(const uint32_t *matrix, uint32_t vector)
+{
+    uint32_t sum = 0;
+    for (; vector != 0; vector >>= 1, matrix++)
+        if (vector & 1) sum ^= *matrix;
+    return sum;
+}
+
+/**
+ * @fn void ageratum_crcInitialize(void)
+ * @brief Build the CRC32C lookup tables and poll the processor for hardware
+ * support. This is run automatically before @c main.
+ * @since v0.0.0.37
+ */
+[[gnu::constructor]] [[gnu::cold]]
+static void ageratum_crcInitialize(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (size_t j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ (AGERATUM_CRC32C_POLYNOMIAL & -(crc & 1));
+        ageratum_crcTable[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (size_t j = 1; j < 8; j++)
+        {
+            const uint32_t previous = ageratum_crcTable[j - 1][i];
+            ageratum_crcTable[j][i] =
+                (previous >> 8) ^ ageratum_crcTable[0][previous & 0xFF];
+        }
+    }
+
+    // Start from the operator for a single zero bit, then square it until it
+    // appends a full stride of zero bytes.
+    uint32_t odd[32], even[32];
+    odd[0] = AGERATUM_CRC32C_POLYNOMIAL;
+    for (size_t i = 1; i < 32; i++) odd[i] = 1U << (i - 1);
+    for (size_t i = 0; i < 32; i++)
+        even[i] = ageratum_gf2Multiply(odd, odd[i]);
+    for (size_t i = 0; i < 32; i++)
+        odd[i] = ageratum_gf2Multiply(even, even[i]);
+    uint32_t *zeroes = odd, *scratch = even;
+    for (size_t length = AGERATUM_CRC32C_STRIDE * 2; length > 1; length >>= 1)
+    {
+        for (size_t i = 0; i < 32; i++)
+            scratch[i] = ageratum_gf2Multiply(zeroes, zeroes[i]);
+        uint32_t *swap = zeroes;
+        zeroes = scratch;
+        scratch = swap;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+        for (size_t j = 0; j < 4; j++)
+            ageratum_crcShiftTable[j][i] =
+                ageratum_gf2Multiply(zeroes, i << (j * 8));
+
+#ifdef __x86_64__
+    __builtin_cpu_init();
+    ageratum_crcHardware = __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+/**
+ * @fn uint32_t ageratum_crc32cSoftware(uint32_t crc, const uint8_t *data,
+ * size_t size)
+ * @brief The portable slicing-by-8 CRC32C path. This operates on the raw,
+ * uninverted CRC register.
+ * @since v0.0.0.37
+ *
+ * @param[in] crc The current CRC register.
+ * @param[in] data The bytes to be checksummed.
+ * @param[in] size The count of bytes to be checksummed.
+ *
+ * @return The updated CRC register.
+ */
+[[gnu::nonnull(2)]] [[gnu::pure]]
+static uint32_t ageratum_crc32cSoftware(uint32_t crc, const uint8_t *data,
+                                        size_t size)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; size > 0 && ((uintptr_t)data & 7) != 0; size--)
+        crc = ageratum_crcTable[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        uint64_t word;
+        __builtin_memcpy(&word, data, 8);
+        word ^= crc;
+        crc = ageratum_crcTable[7][word & 0xFF] ^
+              ageratum_crcTable[6][(word >> 8) & 0xFF] ^
+              ageratum_crcTable[5][(word >> 16) & 0xFF] ^
+              ageratum_crcTable[4][(word >> 24) & 0xFF] ^
+              ageratum_crcTable[3][(word >> 32) & 0xFF] ^
+              ageratum_crcTable[2][(word >> 40) & 0xFF] ^
+              ageratum_crcTable[1][(word >> 48) & 0xFF] ^
+              ageratum_crcTable[0][word >> 56];
+    }
+#endif
+    for (; size > 0; size--)
+        crc = ageratum_crcTable[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#ifdef __x86_64__
+/**
+ * @fn uint32_t ageratum_crcShift(uint32_t crc)
+ * @brief Append @ref AGERATUM_CRC32C_STRIDE zero bytes to the given CRC
+ * register.
+ * @since v0.0.0.37
+ *
+ * @param[in] crc The CRC register to be shifted.
+ *
+ * @return The shifted CRC register.
+ */
+[[gnu::pure]]
+static inline uint32_t ageratum_crcShift(uint32_t crc)
+{
+    return ageratum_crcShiftTable[0][crc & 0xFF] ^
+           ageratum_crcShiftTable[1][(crc >> 8) & 0xFF] ^
+           ageratum_crcShiftTable[2][(crc >> 16) & 0xFF] ^
+           ageratum_crcShiftTable[3][crc >> 24];
+}
+
+/**
+ * @fn uint32_t ageratum_crc32cHardware(uint32_t crc, const uint8_t *data,
+ * size_t size)
+ * @brief The SSE4.2 CRC32C path. Large inputs are split into three streams
+ * which are checksummed in lockstep to hide the instruction's latency, then
+ * stitched back together. This operates on the raw, uninverted CRC register.
+ * @since v0.0.0.37
+ *
+ * @param[in] crc The current CRC register.
+ * @param[in] data The bytes to be checksummed.
+ * @param[in] size The count of bytes to be checksummed.
+ *
+ * @return The updated CRC register.
+ */
+[[gnu::nonnull(2)]] [[gnu::pure]] [[gnu::target("sse4.2")]]
+static uint32_t ageratum_crc32cHardware(uint32_t crc, const uint8_t *data,
+                                        size_t size)
+{
+    for (; size > 0 && ((uintptr_t)data & 7) != 0; size--)
+        crc = _mm_crc32_u8(crc, *data++);
+
+    uint64_t crc0 = crc;
+    for (; size >= AGERATUM_CRC32C_STRIDE * 3;
+         size -= AGERATUM_CRC32C_STRIDE * 3)
+    {
+        uint64_t crc1 = 0, crc2 = 0;
+        const uint8_t *const end = data + AGERATUM_CRC32C_STRIDE;
+        for (; data < end; data += 8)
+        {
+            uint64_t words[3];
+            __builtin_memcpy(&words[0], data, 8);
+            __builtin_memcpy(&words[1], data + AGERATUM_CRC32C_STRIDE, 8);
+            __builtin_memcpy(&words[2], data + AGERATUM_CRC32C_STRIDE * 2, 8);
+            crc0 = _mm_crc32_u64(crc0, words[0]);
+            crc1 = _mm_crc32_u64(crc1, words[1]);
+            crc2 = _mm_crc32_u64(crc2, words[2]);
+        }
+        crc0 = ageratum_crcShift((uint32_t)crc0) ^ crc1;
+        crc0 = ageratum_crcShift((uint32_t)crc0) ^ crc2;
+        data += AGERATUM_CRC32C_STRIDE * 2;
+    }
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        uint64_t word;
+        __builtin_memcpy(&word, data, 8);
+        crc0 = _mm_crc32_u64(crc0, word);
+    }
+
+    crc = (uint32_t)crc0;
+    for (; size > 0; size--) crc = _mm_crc32_u8(crc, *data++);
+    return crc;
+}
+#endif
+
 /**
  * @fn void ageratum_strncat(char *dest, const char *const src, size_t
  * *consumed)
@@ -517,6 +1268,7 @@ void ageratum_createFilepath(const ageratum_file_t *const file, char *path)
         ageratum_strncat(path, file->basename, &consumed);
         ageratum_strncat(path, info[1], &consumed);
     }
+    path[consumed] = 0;
 }
 
 bool ageratum_openFile(ageratum_file_t *file,
@@ -560,141 +1312,1962 @@ bool ageratum_getFileSize(ageratum_file_t *file)
     return true;
 }
 
-bool ageratum_loadFile(const ageratum_file_t *const file, char *contents)
+/**
+ * @fn FILE *ageratum_openTemporary(const ageratum_file_t *const file, char
+ * *path, char *temporaryPath)
+ * @brief Open a temporary sibling of the given file for writing, to be moved
+ * over the file by @ref ageratum_commitTemporary once it's complete.
+ * @since v0.0.0.40
+ *
+ * @param[in] file The file structure to be operated on.
+ * @param[out] path The path of the file. This buffer should be at least as
+ * large as specified in @ref AGERATUM_MAX_PATH_LENGTH.
+ * @param[out] temporaryPath The path of the temporary file. This buffer should
+ * be at least as large as specified in @ref AGERATUM_MAX_PATH_LENGTH.
+ *
+ * @return The handle of the temporary file, or @c nullptr on failure.
+ */
+[[gnu::nonnull(1, 2, 3)]] [[gnu::cold]]
+static FILE *ageratum_openTemporary(const ageratum_file_t *const file,
+                                    char *path, char *temporaryPath)
 {
-    if (__builtin_expect(
-            fread(contents, 1, file->size, file->handle) != file->size, 0))
+    ageratum_createFilepath(file, path);
+    size_t length = 0;
+    for (; path[length] != 0; length++) temporaryPath[length] = path[length];
+    if (__builtin_expect(length + sizeof(".tmp") > AGERATUM_MAX_PATH_LENGTH,
+                         0))
     {
-        primrose_log(ERROR, "Failed to properly read file '%s'.",
-                     file->basename);
-        return false;
+        primrose_log(ERROR, "Path '%s' is too long.", path);
+        return nullptr;
     }
-    primrose_log(VERBOSE_OK, "Loaded %zu bytes of file '%s'.", file->size,
-                 file->basename);
-    return true;
+    __builtin_memcpy(temporaryPath + length, ".tmp", sizeof(".tmp"));
+
+    FILE *handle = fopen(temporaryPath, "w");
+    if (__builtin_expect(handle == nullptr, 0))
+    {
+        primrose_log(ERROR, "Failed to open file '%s'.", temporaryPath);
+        return nullptr;
+    }
+    return handle;
 }
 
-bool ageratum_writeFile(const ageratum_file_t *const file,
-                        const char *const contents)
+/**
+ * @fn bool ageratum_commitTemporary(FILE *handle, const char *const path,
+ * const char *const temporaryPath, bool keep)
+ * @brief Close a file opened by @ref ageratum_openTemporary, and either
+ * atomically move it over its original or discard it.
+ * @since v0.0.0.40
+ *
+ * @param[in] handle The handle of the temporary file.
+ * @param[in] path The path of the file.
+ * @param[in] temporaryPath The path of the temporary file.
+ * @param[in] keep Whether or not the temporary file is complete, and should
+ * replace the original.
+ *
+ * @return A boolean value representing whether or not the file replaced its
+ * original. On failure, a message will be posted to @c stderr alongside the
+ * current @c ERRNO value.
+ */
+[[gnu::nonnull(1, 2, 3)]] [[gnu::cold]]
+static bool ageratum_commitTemporary(FILE *handle, const char *const path,
+                                     const char *const temporaryPath,
+                                     bool keep)
 {
-    if (__builtin_expect(
-            fwrite(contents, 1, file->size, file->handle) != file->size, 0))
+    if (__builtin_expect(fclose(handle) != 0, 0))
     {
-        primrose_log(ERROR, "Failed to write to file '%s'.", file->basename);
-        return false;
+        primrose_log(ERROR, "Failed to close file '%s'.", temporaryPath);
+        keep = false;
     }
-    primrose_log(VERBOSE_OK, "Wrote %zu bytes to file '%s'.", file->size,
-                 file->basename);
+    if (keep && __builtin_expect(rename(temporaryPath, path) != 0, 0))
+    {
+        primrose_log(ERROR, "Failed to move file '%s' to '%s'.",
+                     temporaryPath, path);
+        keep = false;
+    }
+    if (!keep) remove(temporaryPath);
+    return keep;
+}
+
+uint32_t ageratum_crc32c(uint32_t crc, const void *const data, size_t size)
+{
+#ifdef __x86_64__
+    if (__builtin_expect(ageratum_crcHardware, 1))
+        return ~ageratum_crc32cHardware(~crc, data, size);
+#endif
+    return ~ageratum_crc32cSoftware(~crc, data, size);
+}
+
+/**
+ * @fn bool ageratum_streamChecksum(const ageratum_file_t *const file, char
+ * *contents, uint32_t *checksum)
+ * @brief Read and checksum the remainder of the given file in chunks of @ref
+ * AGERATUM_CHECKSUM_CHUNK_SIZE. Each chunk is hashed straight after it's read,
+ * while it's still in cache, rather than making a second pass over the whole
+ * file. The file's size must have been polled via @ref ageratum_getFileSize.
+ * @since v0.0.0.37
+ *
+ * @param[in] file The file structure to be operated on.
+ * @param[out] contents An array of bytes in which the file's contents will be
+ * inserted, or @c nullptr to discard them.
+ * @param[out] checksum The checksum of the file's contents.
+ *
+ * @return A boolean value representing whether or not the file was read
+ * successfully.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_streamChecksum(const ageratum_file_t *const file,
+                                    char *contents, uint32_t *checksum)
+{
+    char buffer[AGERATUM_CHECKSUM_CHUNK_SIZE];
+    uint32_t crc = 0;
+    for (size_t remaining = file->size; remaining > 0;)
+    {
+        const size_t chunk = remaining < AGERATUM_CHECKSUM_CHUNK_SIZE
+                                 ? remaining
+                                 : AGERATUM_CHECKSUM_CHUNK_SIZE;
+        char *destination = contents == nullptr ? buffer : contents;
+        if (__builtin_expect(
+                fread(destination, 1, chunk, file->handle) != chunk, 0))
+        {
+            primrose_log(ERROR, "Failed to properly read file '%s'.",
+                         file->basename);
+            return false;
+        }
+        crc = ageratum_crc32c(crc, destination, chunk);
+        if (contents != nullptr) contents += chunk;
+        remaining -= chunk;
+    }
+    *checksum = crc;
     return true;
 }
 
-bool ageratum_executeFile(const ageratum_file_t *const file,
-                          const char *const *const argv, size_t argc,
-                          int *status)
+/**
+ * @fn bool ageratum_matchChecksum(const ageratum_file_t *const file, uint32_t
+ * checksum)
+ * @brief Compare a freshly calculated checksum against the one recorded for
+ * the given file.
+ * @since v0.0.0.43
+ *
+ * @param[in] file The file structure to be operated on.
+ * @param[in] checksum The freshly calculated checksum.
+ *
+ * @return Whether or not the checksums match. On mismatch, a message will be
+ * posted to @c stderr.
+ */
+[[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_matchChecksum(const ageratum_file_t *const file,
+                                   uint32_t checksum)
 {
-    char path[AGERATUM_MAX_PATH_LENGTH];
-    ageratum_createFilepath(file, path);
+    if (__builtin_expect(checksum == file->checksum, 1)) return true;
+    primrose_log(ERROR,
+                 "File '%s' is corrupted. Expected checksum %08X, got %08X.",
+                 file->basename, file->checksum, checksum);
+    return false;
+}
 
-    if (__builtin_expect(access(path, X_OK) == -1, 0))
+bool ageratum_checksumFile(ageratum_file_t *file)
+{
+    if (!ageratum_streamChecksum(file, nullptr, &file->checksum))
+        return false;
+    file->verify = true;
+    primrose_log(VERBOSE_OK, "Checksummed file '%s': %08X.", file->basename,
+                 file->checksum);
+    return true;
+}
+
+/**
+ * @fn size_t ageratum_basenameLength(const char *const basename)
+ * @brief Measure a basename, never reading more than @ref
+ * AGERATUM_MAX_PATH_LENGTH characters of it.
+ * @since v0.0.0.43
+ *
+ * @param[in] basename The basename to be measured.
+ *
+ * @return The length of the basename, or @ref AGERATUM_MAX_PATH_LENGTH if it's
+ * too long to be stored.
+ */
+[[gnu::nonnull(1)]] [[gnu::pure]]
+static size_t ageratum_basenameLength(const char *const basename)
+{
+    size_t length = 0;
+    while (length < AGERATUM_MAX_PATH_LENGTH && basename[length] != 0)
+        length++;
+    return length;
+}
+
+/**
+ * @fn bool ageratum_writeEntry(FILE *handle, const ageratum_file_t *const
+ * file, size_t length)
+ * @brief Write the framing shared by every entry of prefetch profiles and
+ * checksum manifests: one byte of type, one byte of basename length, then the
+ * basename itself.
+ * @since v0.0.0.43
+ *
+ * @param[in] handle The handle to write to.
+ * @param[in] file The file structure to be written.
+ * @param[in] length The length of the file's basename, as measured by @ref
+ * ageratum_basenameLength. This must be below @ref AGERATUM_MAX_PATH_LENGTH.
+ *
+ * @return A boolean value representing whether or not the entry was written
+ * successfully.
+ */
+[[gnu::nonnull(1, 2)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_writeEntry(FILE *handle,
+                                const ageratum_file_t *const file,
+                                size_t length)
+{
+    const unsigned char header[2] = {file->type, length};
+    return fwrite(header, 1, 2, handle) == 2 &&
+           fwrite(file->basename, 1, length, handle) == length;
+}
+
+/**
+ * @fn bool ageratum_readEntry(FILE *handle, ageratum_file_t *file, char
+ * *basename, bool *valid)
+ * @brief Read the framing written by @ref ageratum_writeEntry.
+ * @since v0.0.0.43
+ *
+ * @param[in] handle The handle to read from.
+ * @param[out] file The file structure in which the type and basename are
+ * stored.
+ * @param[out] basename The storage for the basename. This buffer should be at
+ * least as large as specified in @ref AGERATUM_MAX_PATH_LENGTH.
+ * @param[out] valid Set to @c false should the entry be truncated or
+ * malformed, and left untouched at a clean end of file.
+ *
+ * @return Whether or not an entry was read.
+ */
+[[gnu::nonnull(1, 2, 3, 4)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_readEntry(FILE *handle, ageratum_file_t *file,
+                               char *basename, bool *valid)
+{
+    unsigned char header[2];
+    const size_t headerRead = fread(header, 1, 2, handle);
+    if (headerRead != 2)
     {
-        primrose_log(ERROR, "Cannot execute file '%s'.", path);
+        if (headerRead != 0) *valid = false;
         return false;
     }
-
-    pid_t pid = fork();
-    if (__builtin_expect(pid == -1, 0))
+    if (header[0] >= AGERATUM_TYPE_COUNT ||
+        header[1] >= AGERATUM_MAX_PATH_LENGTH ||
+        fread(basename, 1, header[1], handle) != header[1])
     {
-        primrose_log(ERROR, "Failed to fork process.");
+        *valid = false;
         return false;
     }
+    basename[header[1]] = 0;
+    file->basename = basename;
+    file->type = header[0];
+    return true;
+}
 
-    char *trueArgv[argc + 2];
-    trueArgv[0] = path;
-    for (size_t i = 0; i < argc; i++) trueArgv[i + 1] = (char *)argv[i];
-    trueArgv[argc + 1] = nullptr;
+/**
+ * @var const char ageratum_profileMagic[5]
+ * @brief The bytes every prefetch profile begins with, the last being the
+ * format version. Each entry after it is one byte of type, one byte of basename
+ * length, then the basename itself.
+ * @since v0.0.0.38
+ */
+static const char ageratum_profileMagic[5] = {'A', 'G', 'P', 'F', 1};
 
-    // This is executed within the new process.
+/**
+ * @var ageratum_file_t ageratum_profile
+ * @brief The prefetch profile currently being recorded. Its handle is @c
+ * nullptr when nothing is being recorded, and otherwise points at @ref
+ * ageratum_profileTemporaryPath.
+ * @since v0.0.0.38
+ */
+static ageratum_file_t ageratum_profile = {0};
+
+/**
+ * @var char ageratum_profilePath[AGERATUM_MAX_PATH_LENGTH]
+ * @brief The path of the prefetch profile currently being recorded.
+ * @since v0.0.0.41
+ */
+static char ageratum_profilePath[AGERATUM_MAX_PATH_LENGTH];
+
+/**
+ * @var char ageratum_profileTemporaryPath[AGERATUM_MAX_PATH_LENGTH]
+ * @brief The path the prefetch profile currently being recorded is written to,
+ * until @ref ageratum_stopProfile moves it over @ref ageratum_profilePath. This
+ * keeps the previous profile intact while it may still be being replayed.
+ * @since v0.0.0.41
+ */
+static char ageratum_profileTemporaryPath[AGERATUM_MAX_PATH_LENGTH];
+
+/**
+ * @var pthread_mutex_t ageratum_profileLock
+ * @brief The lock guarding @ref ageratum_profile, @ref ageratum_profileSeen,
+ * and @ref ageratum_profileNames.
+ * @since v0.0.0.38
+ */
+static pthread_mutex_t ageratum_profileLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @struct ageratum_profile_slot Ageratum.h "Ageratum.h"
+ * @brief A single slot of @ref ageratum_profileSeen.
+ * @since v0.0.0.45
+ */
+typedef struct ageratum_profile_slot
+{
+    /**
+     * @property hash
+     * @brief The hash of the file's type and basename, or 0 if the slot is
+     * empty.
+     * @since v0.0.0.45
+     */
+    uint32_t hash;
+    /**
+     * @property offset
+     * @brief The offset of the file's entry within @ref ageratum_profileNames.
+     * @since v0.0.0.45
+     */
+    uint32_t offset;
+} ageratum_profile_slot_t;
+
+/**
+ * @var ageratum_profile_slot_t ageratum_profileSeen[AGERATUM_PROFILE_CAPACITY]
+ * @brief An open-addressed set of every file recorded so far, so that only a
+ * file's first load makes it into the profile. Hashes only narrow the search;
+ * a match is confirmed against the entry kept in @ref ageratum_profileNames.
+ * @since v0.0.0.38
+ */
+static ageratum_profile_slot_t ageratum_profileSeen[AGERATUM_PROFILE_CAPACITY];
+
+/**
+ * @var unsigned char ageratum_profileNames[AGERATUM_PROFILE_CAPACITY * 32]
+ * @brief The entry of every file recorded so far, encoded exactly as it was
+ * written into the profile.
+ * @since v0.0.0.45
+ */
+static unsigned char ageratum_profileNames[AGERATUM_PROFILE_CAPACITY * 32];
+
+/**
+ * @var size_t ageratum_profileNamesSize
+ * @brief The count of bytes used within @ref ageratum_profileNames.
+ * @since v0.0.0.45
+ */
+static size_t ageratum_profileNamesSize = 0;
+
+/**
+ * @var size_t ageratum_profileCount
+ * @brief The count of files recorded into the current profile.
+ * @since v0.0.0.38
+ */
+static size_t ageratum_profileCount = 0;
+
+/**
+ * @fn void ageratum_appendProfile(const ageratum_file_t *const file)
+ * @brief Append the given file to the current prefetch profile, if one is being
+ * recorded and the file hasn't been seen yet.
+ * @since v0.0.0.38
+ *
+ * @param[in] file The file which was loaded.
+ */
+[[gnu::nonnull(1)]] [[gnu::cold]]
+static void ageratum_appendProfile(const ageratum_file_t *const file)
+{
+    if (file->type == AGERATUM_PROFILE) return;
+
+    const size_t length = ageratum_basenameLength(file->basename);
+    if (length == AGERATUM_MAX_PATH_LENGTH) return;
+    uint32_t hash = ageratum_crc32c(file->type, file->basename, length);
+    if (hash == 0) hash = 1;
+
+    pthread_mutex_lock(&ageratum_profileLock);
+    // Recording may have been stopped since the unlocked check. One slot is
+    // always left empty so that probing terminates.
+    bool record =
+        ageratum_profile.handle != nullptr &&
+        ageratum_profileCount < AGERATUM_PROFILE_CAPACITY - 1 &&
+        ageratum_profileNamesSize + length + 2 <= sizeof(ageratum_profileNames);
+
+    size_t slot = hash & (AGERATUM_PROFILE_CAPACITY - 1);
+    while (record && ageratum_profileSeen[slot].hash != 0)
+    {
+        const unsigned char *const entry =
+            &ageratum_profileNames[ageratum_profileSeen[slot].offset];
+        if (ageratum_profileSeen[slot].hash == hash &&
+            entry[0] == file->type && entry[1] == length &&
+            __builtin_memcmp(entry + 2, file->basename, length) == 0)
+            record = false;
+        slot = (slot + 1) & (AGERATUM_PROFILE_CAPACITY - 1);
+    }
+
+    if (record)
+    {
+        unsigned char *const entry =
+            &ageratum_profileNames[ageratum_profileNamesSize];
+        entry[0] = file->type;
+        entry[1] = length;
+        __builtin_memcpy(entry + 2, file->basename, length);
+        ageratum_profileSeen[slot].hash = hash;
+        ageratum_profileSeen[slot].offset = ageratum_profileNamesSize;
+        ageratum_profileNamesSize += length + 2;
+        ageratum_profileCount++;
+
+        if (__builtin_expect(
+                !ageratum_writeEntry(ageratum_profile.handle, file, length),
+                0))
+            primrose_log(WARNING,
+                         "Failed to record file '%s' into profile '%s'.",
+                         file->basename, ageratum_profile.basename);
+    }
+    pthread_mutex_unlock(&ageratum_profileLock);
+}
+
+/**
+ * @fn void ageratum_recordLoad(const ageratum_file_t *const file)
+ * @brief Record a successful load into the current prefetch profile, should
+ * one be being recorded.
+ * @since v0.0.0.41
+ *
+ * @param[in] file The file which was loaded.
+ */
+[[gnu::nonnull(1)]] [[gnu::hot]]
+static inline void ageratum_recordLoad(const ageratum_file_t *const file)
+{
     if (__builtin_expect(
-            pid == 0 && execve(path, (char *const *)trueArgv, nullptr) == -1,
+            __atomic_load_n(&ageratum_profile.handle, __ATOMIC_ACQUIRE) !=
+                nullptr,
             0))
+        ageratum_appendProfile(file);
+}
+
+bool ageratum_startProfile(const ageratum_file_t *const profile)
+{
+    pthread_mutex_lock(&ageratum_profileLock);
+    if (__builtin_expect(ageratum_profile.handle != nullptr, 0))
     {
-        primrose_log(ERROR, "Failed to execute file '%s'.", path);
+        pthread_mutex_unlock(&ageratum_profileLock);
+        primrose_log(ERROR, "Already recording profile '%s'.",
+                     ageratum_profile.basename);
         return false;
     }
 
-    int processStatus = 0;
-    pid_t waitStatus = waitpid(pid, &processStatus, 0);
-    if (__builtin_expect(waitStatus == (pid_t)-1, 0))
+    // Record into a temporary file, since the previous profile may still be
+    // being replayed.
+    ageratum_file_t file = *profile;
+    file.handle = ageratum_openTemporary(&file, ageratum_profilePath,
+                                         ageratum_profileTemporaryPath);
+    if (file.handle == nullptr)
     {
-        primrose_log(WARNING, "Execution of '%s' interrupted by a signal.",
-                     path);
+        pthread_mutex_unlock(&ageratum_profileLock);
+        return false;
+    }
+    if (__builtin_expect(fwrite(ageratum_profileMagic, 1,
+                                sizeof(ageratum_profileMagic),
+                                file.handle) != sizeof(ageratum_profileMagic),
+                         0))
+    {
+        primrose_log(ERROR, "Failed to write to profile '%s'.", file.basename);
+        (void)ageratum_commitTemporary(file.handle, ageratum_profilePath,
+                                       ageratum_profileTemporaryPath, false);
+        pthread_mutex_unlock(&ageratum_profileLock);
         return false;
     }
 
-    // This could very likely happen or not happen. Don't expect anything.
-    if (!WIFEXITED(processStatus))
+    for (size_t i = 0; i < AGERATUM_PROFILE_CAPACITY; i++)
+        ageratum_profileSeen[i].hash = 0;
+    ageratum_profileCount = 0;
+    ageratum_profileNamesSize = 0;
+    ageratum_profile.basename = file.basename;
+    ageratum_profile.type = file.type;
+    __atomic_store_n(&ageratum_profile.handle, file.handle, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&ageratum_profileLock);
+
+    primrose_log(VERBOSE_OK, "Began recording profile '%s'.", file.basename);
+    return true;
+}
+
+bool ageratum_stopProfile(void)
+{
+    pthread_mutex_lock(&ageratum_profileLock);
+    const ageratum_file_t file = ageratum_profile;
+    __atomic_store_n(&ageratum_profile.handle, nullptr, __ATOMIC_RELAXED);
+    const size_t count = ageratum_profileCount;
+
+    if (__builtin_expect(file.handle == nullptr, 0))
     {
-        primrose_log(WARNING,
-                     "File '%s' ended execution with an unexpected result.",
-                     path);
+        pthread_mutex_unlock(&ageratum_profileLock);
+        primrose_log(ERROR, "No profile is being recorded.");
         return false;
     }
-    *status = WEXITSTATUS(processStatus);
-    primrose_log(VERBOSE_OK, "Executed file '%s'. Exited with status code %d.",
-                 file->basename, *status);
+    // Renaming over the old profile leaves any replay of it reading the
+    // original contents.
+    const bool committed =
+        ageratum_commitTemporary(file.handle, ageratum_profilePath,
+                                 ageratum_profileTemporaryPath, true);
+    pthread_mutex_unlock(&ageratum_profileLock);
+    if (!committed) return false;
+    primrose_log(VERBOSE_OK, "Recorded %zu files into profile '%s'.", count,
+                 file.basename);
     return true;
 }
 
-bool ageratum_glslToSPIRV(const ageratum_file_t *const file)
+/**
+ * @fn void *ageratum_replayWorker(void *data)
+ * @brief The body of the background thread spawned by @ref
+ * ageratum_replayProfile. Each recorded file is opened just long enough to
+ * ask the kernel to begin reading it in.
+ * @since v0.0.0.38
+ *
+ * @param[in] data The handle of the profile, positioned just after its
+ * magic. This is closed by the thread.
+ *
+ * @return Nothing, always @c nullptr.
+ */
+[[gnu::nonnull(1)]] [[gnu::cold]]
+static void *ageratum_replayWorker(void *data)
 {
-    char path[AGERATUM_MAX_PATH_LENGTH];
-    ageratum_createFilepath(file, path);
+    FILE *handle = data;
+    size_t count = 0;
+    char basename[AGERATUM_MAX_PATH_LENGTH];
+    ageratum_file_t file = {0};
+    bool valid = true;
+    while (ageratum_readEntry(handle, &file, basename, &valid))
+    {
+        char path[AGERATUM_MAX_PATH_LENGTH];
+        ageratum_createFilepath(&file, path);
 
-    char outputPath[AGERATUM_MAX_PATH_LENGTH];
-    ageratum_file_t outputFile = *file;
-    outputFile.type =
-        (file->type == AGERATUM_GLSL_FRAGMENT ? AGERATUM_SPIRV_FRAGMENT
-                                              : AGERATUM_SPIRV_VERTEX);
-    ageratum_createFilepath(&outputFile, outputPath);
+        const int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+        if (descriptor == -1) continue;
+        (void)posix_fadvise(descriptor, 0, 0, POSIX_FADV_WILLNEED);
+        close(descriptor);
+        count++;
+    }
+    fclose(handle);
+    primrose_log(VERBOSE_OK, "Prefetched %zu files.", count);
+    return nullptr;
+}
 
-    const char *const argv[] = {
-        "--target-env",   "vulkan1.3", "-e",          "main",  "-g0",     "-t",
-        "--glsl-version", "460",       "--spirv-val", "--lto", "--quiet", "-o",
-        outputPath,       path,
-    };
+bool ageratum_replayProfile(const ageratum_file_t *const profile)
+{
+    ageratum_file_t file = *profile;
+    if (!ageratum_openFile(&file, AGERATUM_READ)) return false;
 
-    int status = 0;
-    ageratum_file_t glslangFile = {.basename = "glslang",
-                                   .type = AGERATUM_SYSTEM};
-    if (!ageratum_executeFile(&glslangFile, argv, 14, &status))
+    char magic[sizeof(ageratum_profileMagic)];
+    if (__builtin_expect(fread(magic, 1, sizeof(magic), file.handle) !=
+                                 sizeof(magic) ||
+                             __builtin_memcmp(magic, ageratum_profileMagic,
+                                              sizeof(magic)) != 0,
+                         0))
     {
-        primrose_log(ERROR, "Couldn't compile shader '%s'. Code %d.", path,
-                     status);
+        primrose_log(ERROR, "File '%s' is not a valid profile.",
+                     file.basename);
+        (void)ageratum_closeFile(&file);
         return false;
     }
-    primrose_log(VERBOSE_OK, "Compiled shader '%s'.", path);
+
+    pthread_t thread;
+    if (__builtin_expect(pthread_create(&thread, nullptr,
+                                        ageratum_replayWorker,
+                                        file.handle) != 0,
+                         0))
+    {
+        primrose_log(ERROR, "Failed to spawn replay thread.");
+        (void)ageratum_closeFile(&file);
+        return false;
+    }
+    pthread_detach(thread);
+    primrose_log(VERBOSE_OK, "Began replaying profile '%s'.", file.basename);
     return true;
 }
 
-void ageratum_splitStem(const char *const original, char *filename,
-                        char *extension)
+bool ageratum_loadFile(const ageratum_file_t *const file, char *contents)
 {
-    char *originalCopy = (char *)original;
-    size_t written = 0;
-    while (*originalCopy != '.' && written < AGERATUM_MAX_PATH_LENGTH)
+    if (file->verify)
     {
-        *filename = *originalCopy;
-        filename++;
-        originalCopy++;
-        written++;
+        uint32_t checksum = 0;
+        if (!ageratum_streamChecksum(file, contents, &checksum) ||
+            !ageratum_matchChecksum(file, checksum))
+            return false;
+        primrose_log(VERBOSE_OK, "Loaded and verified %zu bytes of file '%s'.",
+                     file->size, file->basename);
+        ageratum_recordLoad(file);
+        return true;
     }
-    filename[written] = 0;
 
-    while (*originalCopy++ != 0)
+    if (__builtin_expect(
+            fread(contents, 1, file->size, file->handle) != file->size, 0))
     {
-        *extension = *originalCopy;
-        extension++;
+        primrose_log(ERROR, "Failed to properly read file '%s'.",
+                     file->basename);
+        return false;
+    }
+    primrose_log(VERBOSE_OK, "Loaded %zu bytes of file '%s'.", file->size,
+                 file->basename);
+    ageratum_recordLoad(file);
+    return true;
+}
+
+bool ageratum_writeFile(const ageratum_file_t *const file,
+                        const char *const contents)
+{
+    if (__builtin_expect(
+            fwrite(contents, 1, file->size, file->handle) != file->size, 0))
+    {
+        primrose_log(ERROR, "Failed to write to file '%s'.", file->basename);
+        return false;
+    }
+    primrose_log(VERBOSE_OK, "Wrote %zu bytes to file '%s'.", file->size,
+                 file->basename);
+    return true;
+}
+
+bool ageratum_writeChecksummedFile(ageratum_file_t *file,
+                                   const char *const contents)
+{
+    file->checksum = ageratum_crc32c(0, contents, file->size);
+    file->verify = true;
+    return ageratum_writeFile(file, contents);
+}
+
+/**
+ * @struct ageratum_verify_job Ageratum.h "Ageratum.h"
+ * @brief The state shared between every thread of a call to @ref
+ * ageratum_verifyFiles.
+ * @since v0.0.0.37
+ */
+typedef struct ageratum_verify_job
+{
+    /**
+     * @property files
+     * @brief The files being verified.
+     * @since v0.0.0.37
+     */
+    const ageratum_file_t *files;
+    /**
+     * @property results
+     * @brief The optional per-file results.
+     * @since v0.0.0.37
+     */
+    bool *results;
+    /**
+     * @property count
+     * @brief The count of files being verified.
+     * @since v0.0.0.37
+     */
+    size_t count;
+    /**
+     * @property next
+     * @brief The index of the next file to be claimed by a thread.
+     * @since v0.0.0.37
+     */
+    size_t next;
+    /**
+     * @property passed
+     * @brief Whether or not every file verified so far has passed.
+     * @since v0.0.0.37
+     */
+    bool passed;
+} ageratum_verify_job_t;
+
+/**
+ * @fn bool ageratum_verifyFile(const ageratum_file_t *const original)
+ * @brief Open, checksum, and close a single file on behalf of @ref
+ * ageratum_verifyFiles.
+ * @since v0.0.0.37
+ *
+ * @param[in] original The file structure to be verified. This is copied
+ * before being opened, so the caller's structure is never touched.
+ *
+ * @return A boolean value representing whether or not the file passed.
+ */
+[[gnu::nonnull(1)]]
+static bool ageratum_verifyFile(const ageratum_file_t *const original)
+{
+    if (!original->verify) return true;
+
+    ageratum_file_t file = *original;
+    if (!ageratum_openFile(&file, AGERATUM_READ)) return false;
+    // Each file is read exactly once, from start to finish.
+    (void)posix_fadvise(fileno(file.handle), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    uint32_t checksum = 0;
+    bool passed = ageratum_getFileSize(&file);
+    if (passed && original->size != 0 && file.size != original->size)
+    {
+        primrose_log(ERROR,
+                     "File '%s' is corrupted. Expected %zu bytes, got %zu.",
+                     file.basename, original->size, file.size);
+        passed = false;
+    }
+    passed = passed && ageratum_streamChecksum(&file, nullptr, &checksum);
+    if (!ageratum_closeFile(&file)) passed = false;
+    return passed && ageratum_matchChecksum(original, checksum);
+}
+
+/**
+ * @fn void *ageratum_verifyWorker(void *data)
+ * @brief The body of each @ref ageratum_verifyFiles thread. Files are claimed
+ * one at a time, so a few large files don't leave the other threads idle.
+ * @since v0.0.0.37
+ *
+ * @param[in, out] data The shared @ref ageratum_verify_job_t.
+ *
+ * @return Nothing, always @c nullptr.
+ */
+[[gnu::nonnull(1)]]
+static void *ageratum_verifyWorker(void *data)
+{
+    ageratum_verify_job_t *job = data;
+    size_t index;
+    while ((index = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) <
+           job->count)
+    {
+        const bool passed = ageratum_verifyFile(&job->files[index]);
+        if (job->results != nullptr) job->results[index] = passed;
+        if (!passed) __atomic_store_n(&job->passed, false, __ATOMIC_RELAXED);
+    }
+    return nullptr;
+}
+
+bool ageratum_verifyFiles(const ageratum_file_t *const files, size_t count,
+                          bool *results)
+{
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threadCount = processors < 1 ? 1 : (size_t)processors;
+    if (threadCount > count) threadCount = count;
+    if (threadCount > AGERATUM_MAX_VERIFY_THREADS)
+        threadCount = AGERATUM_MAX_VERIFY_THREADS;
+
+    ageratum_verify_job_t job = {
+        .files = files, .results = results, .count = count, .passed = true};
+
+    // The calling thread takes a share of the work itself, so one fewer
+    // thread is spawned than is used.
+    pthread_t threads[AGERATUM_MAX_VERIFY_THREADS];
+    size_t spawned = 0;
+    for (; spawned + 1 < threadCount; spawned++)
+    {
+        if (__builtin_expect(pthread_create(&threads[spawned], nullptr,
+                                            ageratum_verifyWorker, &job) != 0,
+                             0))
+        {
+            primrose_log(WARNING, "Failed to spawn verification thread.");
+            break;
+        }
+    }
+    ageratum_verifyWorker(&job);
+    for (size_t i = 0; i < spawned; i++) pthread_join(threads[i], nullptr);
+
+    if (!job.passed)
+    {
+        primrose_log(ERROR, "Failed to verify all of %zu files.", count);
+        return false;
+    }
+    primrose_log(VERBOSE_OK, "Verified %zu files across %zu threads.", count,
+                 spawned + 1);
+    return true;
+}
+
+/**
+ * @var const char ageratum_manifestMagic[5]
+ * @brief The bytes every checksum manifest begins with, the last being the
+ * format version. Each entry after it is one byte of type, one byte of basename
+ * length, the basename itself, then the file's size in eight bytes and its
+ * checksum in four, both little-endian.
+ * @since v0.0.0.40
+ */
+static const char ageratum_manifestMagic[5] = {'A', 'G', 'M', 'F', 1};
+
+/**
+ * @fn int ageratum_compareEntries(const void *first, const void *second)
+ * @brief Order two manifest entries by type, then basename, so that a loaded
+ * manifest may be binary searched.
+ * @since v0.0.0.44
+ *
+ * @param[in] first The first entry.
+ * @param[in] second The second entry.
+ *
+ * @return Less than, equal to, or greater than zero as the first entry sorts
+ * before, alongside, or after the second.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static int ageratum_compareEntries(const void *first, const void *second)
+{
+    const ageratum_file_t *const left = first;
+    const ageratum_file_t *const right = second;
+    if (left->type != right->type) return left->type < right->type ? -1 : 1;
+    return __builtin_strncmp(left->basename, right->basename,
+                             AGERATUM_MAX_PATH_LENGTH);
+}
+
+bool ageratum_writeManifest(const ageratum_file_t *const manifest,
+                            const ageratum_file_t *const files, size_t count)
+{
+    char path[AGERATUM_MAX_PATH_LENGTH];
+    char temporaryPath[AGERATUM_MAX_PATH_LENGTH];
+    FILE *handle = ageratum_openTemporary(manifest, path, temporaryPath);
+    if (handle == nullptr) return false;
+
+    bool written = fwrite(ageratum_manifestMagic, 1,
+                          sizeof(ageratum_manifestMagic),
+                          handle) == sizeof(ageratum_manifestMagic);
+    size_t recorded = 0;
+    for (size_t i = 0; i < count && written; i++)
+    {
+        if (!files[i].verify) continue;
+
+        const size_t length = ageratum_basenameLength(files[i].basename);
+        if (__builtin_expect(length == AGERATUM_MAX_PATH_LENGTH, 0))
+        {
+            primrose_log(ERROR, "Basename of file '%.*s' is too long.",
+                         AGERATUM_MAX_PATH_LENGTH, files[i].basename);
+            written = false;
+            break;
+        }
+
+        unsigned char footer[12];
+        for (size_t j = 0; j < 8; j++)
+            footer[j] = (uint64_t)files[i].size >> (j * 8);
+        for (size_t j = 0; j < 4; j++)
+            footer[8 + j] = files[i].checksum >> (j * 8);
+        written = ageratum_writeEntry(handle, &files[i], length) &&
+                  fwrite(footer, 1, 12, handle) == 12;
+        recorded++;
+    }
+    if (__builtin_expect(!written, 0))
+        primrose_log(ERROR, "Failed to write to file '%s'.", temporaryPath);
+
+    if (!ageratum_commitTemporary(handle, path, temporaryPath, written))
+        return false;
+    primrose_log(VERBOSE_OK, "Wrote %zu entries to manifest '%s'.", recorded,
+                 manifest->basename);
+    return true;
+}
+
+bool ageratum_loadManifest(const ageratum_file_t *const manifest,
+                           ageratum_file_t *files,
+                           char (*names)[AGERATUM_MAX_PATH_LENGTH],
+                           size_t *count)
+{
+    ageratum_file_t file = *manifest;
+    if (!ageratum_openFile(&file, AGERATUM_READ)) return false;
+
+    char magic[sizeof(ageratum_manifestMagic)];
+    bool loaded = fread(magic, 1, sizeof(magic), file.handle) ==
+                      sizeof(magic) &&
+                  __builtin_memcmp(magic, ageratum_manifestMagic,
+                                   sizeof(magic)) == 0;
+    size_t loadedCount = 0;
+    ageratum_file_t entry = {.verify = true};
+    char name[AGERATUM_MAX_PATH_LENGTH];
+    while (loaded && ageratum_readEntry(file.handle, &entry, name, &loaded))
+    {
+        if (__builtin_expect(loadedCount == *count, 0))
+        {
+            primrose_log(ERROR, "Manifest '%s' holds more than %zu entries.",
+                         file.basename, *count);
+            (void)ageratum_closeFile(&file);
+            return false;
+        }
+
+        unsigned char footer[12];
+        loaded = fread(footer, 1, 12, file.handle) == 12;
+        if (!loaded) break;
+
+        entry.size = 0;
+        entry.checksum = 0;
+        for (size_t j = 0; j < 8; j++)
+            entry.size |= (size_t)footer[j] << (j * 8);
+        for (size_t j = 0; j < 4; j++)
+            entry.checksum |= (uint32_t)footer[8 + j] << (j * 8);
+
+        __builtin_memcpy(names[loadedCount], name, sizeof(name));
+        entry.basename = names[loadedCount];
+        files[loadedCount++] = entry;
+    }
+
+    if (__builtin_expect(!loaded, 0))
+    {
+        primrose_log(ERROR, "File '%s' is not a valid manifest.",
+                     file.basename);
+        (void)ageratum_closeFile(&file);
+        return false;
+    }
+    if (!ageratum_closeFile(&file)) return false;
+    qsort(files, loadedCount, sizeof(ageratum_file_t),
+          ageratum_compareEntries);
+    *count = loadedCount;
+    primrose_log(VERBOSE_OK, "Loaded %zu entries from manifest '%s'.",
+                 loadedCount, file.basename);
+    return true;
+}
+
+bool ageratum_applyManifest(const ageratum_file_t *const entries, size_t count,
+                            ageratum_file_t *file)
+{
+    const ageratum_file_t *const entry =
+        bsearch(file, entries, count, sizeof(ageratum_file_t),
+                ageratum_compareEntries);
+    if (entry == nullptr) return false;
+
+    file->checksum = entry->checksum;
+    file->verify = true;
+    return true;
+}
+
+bool ageratum_executeFile(const ageratum_file_t *const file,
+                          const char *const *const argv, size_t argc,
+                          int *status)
+{
+    char path[AGERATUM_MAX_PATH_LENGTH];
+    ageratum_createFilepath(file, path);
+
+    if (__builtin_expect(access(path, X_OK) == -1, 0))
+    {
+        primrose_log(ERROR, "Cannot execute file '%s'.", path);
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (__builtin_expect(pid == -1, 0))
+    {
+        primrose_log(ERROR, "Failed to fork process.");
+        return false;
+    }
+
+    char *trueArgv[argc + 2];
+    trueArgv[0] = path;
+    for (size_t i = 0; i < argc; i++) trueArgv[i + 1] = (char *)argv[i];
+    trueArgv[argc + 1] = nullptr;
+
+    // This is executed within the new process.
+    if (__builtin_expect(
+            pid == 0 && execve(path, (char *const *)trueArgv, nullptr) == -1,
+            0))
+    {
+        primrose_log(ERROR, "Failed to execute file '%s'.", path);
+        return false;
+    }
+
+    int processStatus = 0;
+    pid_t waitStatus = waitpid(pid, &processStatus, 0);
+    if (__builtin_expect(waitStatus == (pid_t)-1, 0))
+    {
+        primrose_log(WARNING, "Execution of '%s' interrupted by a signal.",
+                     path);
+        return false;
+    }
+
+    // This could very likely happen or not happen. Don't expect anything.
+    if (!WIFEXITED(processStatus))
+    {
+        primrose_log(WARNING,
+                     "File '%s' ended execution with an unexpected result.",
+                     path);
+        return false;
+    }
+    *status = WEXITSTATUS(processStatus);
+    primrose_log(VERBOSE_OK, "Executed file '%s'. Exited with status code %d.",
+                 file->basename, *status);
+    return true;
+}
+
+bool ageratum_glslToSPIRV(const ageratum_file_t *const file)
+{
+    char path[AGERATUM_MAX_PATH_LENGTH];
+    ageratum_createFilepath(file, path);
+
+    char outputPath[AGERATUM_MAX_PATH_LENGTH];
+    ageratum_file_t outputFile = *file;
+    outputFile.type =
+        (file->type == AGERATUM_GLSL_FRAGMENT ? AGERATUM_SPIRV_FRAGMENT
+                                              : AGERATUM_SPIRV_VERTEX);
+    ageratum_createFilepath(&outputFile, outputPath);
+
+    const char *const argv[] = {
+        "--target-env",   "vulkan1.3", "-e",          "main",  "-g0",     "-t",
+        "--glsl-version", "460",       "--spirv-val", "--lto", "--quiet", "-o",
+        outputPath,       path,
+    };
+
+    int status = 0;
+    ageratum_file_t glslangFile = {.basename = "glslang",
+                                   .type = AGERATUM_SYSTEM};
+    if (!ageratum_executeFile(&glslangFile, argv, 14, &status))
+    {
+        primrose_log(ERROR, "Couldn't compile shader '%s'. Code %d.", path,
+                     status);
+        return false;
+    }
+    primrose_log(VERBOSE_OK, "Compiled shader '%s'.", path);
+    return true;
+}
+
+void ageratum_splitStem(const char *const original, char *filename,
+                        char *extension)
+{
+    char *originalCopy = (char *)original;
+    size_t written = 0;
+    while (*originalCopy != '.' && written < AGERATUM_MAX_PATH_LENGTH)
+    {
+        *filename = *originalCopy;
+        filename++;
+        originalCopy++;
+        written++;
+    }
+    filename[written] = 0;
+
+    while (*originalCopy++ != 0)
+    {
+        *extension = *originalCopy;
+        extension++;
+    }
+}
+
+/**
+ * @struct ageratum_yaml_parser Ageratum.h "Ageratum.h"
+ * @brief The state of a single call to @ref ageratum_parseYAML.
+ * @since v0.0.0.39
+ */
+typedef struct ageratum_yaml_parser
+{
+    /**
+     * @property document
+     * @brief The document being parsed into.
+     * @since v0.0.0.39
+     */
+    ageratum_yaml_document_t *document;
+    /**
+     * @property cursor
+     * @brief The next character to be parsed.
+     * @since v0.0.0.39
+     */
+    const char *cursor;
+    /**
+     * @property lineStart
+     * @brief The first character of the current line.
+     * @since v0.0.0.39
+     */
+    const char *lineStart;
+    /**
+     * @property end
+     * @brief One past the last character of the source.
+     * @since v0.0.0.39
+     */
+    const char *end;
+    /**
+     * @property line
+     * @brief The current line number, for error messages.
+     * @since v0.0.0.39
+     */
+    size_t line;
+    /**
+     * @property started
+     * @brief Whether or not the root node has begun.
+     * @since v0.0.0.42
+     */
+    bool started;
+    /**
+     * @property marked
+     * @brief Whether or not a "---" marker has been seen.
+     * @since v0.0.0.42
+     */
+    bool marked;
+    /**
+     * @property ended
+     * @brief Whether or not a "..." marker has been seen.
+     * @since v0.0.0.42
+     */
+    bool ended;
+    /**
+     * @property spare
+     * @brief Whether or not the document is the capacity left over after a
+     * previous parse, in which case running out of it is not an error.
+     * @since v0.0.0.48
+     */
+    bool spare;
+    /**
+     * @property exhausted
+     * @brief Whether or not the spare capacity was run out of.
+     * @since v0.0.0.48
+     */
+    bool exhausted;
+} ageratum_yaml_parser_t;
+
+[[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlBlock(ageratum_yaml_parser_t *parser, size_t indent,
+                               uint32_t *index, size_t depth);
+
+[[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlFlow(ageratum_yaml_parser_t *parser, uint32_t *index,
+                              size_t depth);
+
+/**
+ * @fn bool ageratum_yamlFail(const ageratum_yaml_parser_t *const parser, const
+ * char *const reason)
+ * @brief Report a parse error at the parser's current line.
+ * @since v0.0.0.39
+ *
+ * @param[in] parser The parser which failed.
+ * @param[in] reason A short description of the failure.
+ *
+ * @return Always @c false, so that callers can return it directly.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::cold]]
+static bool ageratum_yamlFail(const ageratum_yaml_parser_t *const parser,
+                              const char *const reason)
+{
+    primrose_log(ERROR, "Failed to parse YAML, %s on line %zu.", reason,
+                 parser->line);
+    return false;
+}
+
+/**
+ * @fn bool ageratum_yamlAppend(ageratum_yaml_parser_t *parser,
+ * ageratum_yaml_kind_t kind, uint32_t *index)
+ * @brief Claim the next free node of the document.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] kind The kind of the new node.
+ * @param[out] index The index of the new node.
+ *
+ * @return A boolean value representing whether or not there was a node left
+ * to claim.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlAppend(ageratum_yaml_parser_t *parser,
+                                ageratum_yaml_kind_t kind, uint32_t *index)
+{
+    ageratum_yaml_document_t *document = parser->document;
+    if (__builtin_expect(document->count == document->capacity, 0))
+    {
+        // The caller retries in place, so there's nothing to report yet.
+        parser->exhausted = parser->spare;
+        return !parser->spare && ageratum_yamlFail(parser, "ran out of nodes");
+    }
+    *index = document->count++;
+    document->nodes[*index] = (ageratum_yaml_node_t){.kind = kind};
+    return true;
+}
+
+/**
+ * @fn void ageratum_yamlLink(ageratum_yaml_document_t *document, uint32_t
+ * parent, uint32_t *last, uint32_t child)
+ * @brief Append a node to the children of a collection.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] document The document to be operated on.
+ * @param[in] parent The index of the collection.
+ * @param[in, out] last The index of the collection's last child, or 0 if it
+ * has none yet.
+ * @param[in] child The index of the new child.
+ */
+[[gnu::nonnull(1, 3)]]
+static void ageratum_yamlLink(ageratum_yaml_document_t *document,
+                              uint32_t parent, uint32_t *last, uint32_t child)
+{
+    if (*last == 0) document->nodes[parent].child = child;
+    else document->nodes[*last].next = child;
+    *last = child;
+    document->nodes[parent].count++;
+}
+
+/**
+ * @fn const char *ageratum_yamlLineEnd(const ageratum_yaml_parser_t *const
+ * parser)
+ * @brief Find the end of the parser's current line.
+ * @since v0.0.0.39
+ *
+ * @param[in] parser The parser to be operated on.
+ *
+ * @return The line's newline character, or the end of the source.
+ */
+[[gnu::nonnull(1)]] [[gnu::pure]]
+static const char *
+ageratum_yamlLineEnd(const ageratum_yaml_parser_t *const parser)
+{
+    if (parser->cursor >= parser->end) return parser->end;
+    const char *end = __builtin_memchr(parser->cursor, '\n',
+                                       parser->end - parser->cursor);
+    return end == nullptr ? parser->end : end;
+}
+
+/**
+ * @fn void ageratum_yamlNextLine(ageratum_yaml_parser_t *parser)
+ * @brief Move the parser to the start of the next line.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ */
+[[gnu::nonnull(1)]]
+static void ageratum_yamlNextLine(ageratum_yaml_parser_t *parser)
+{
+    const char *end = ageratum_yamlLineEnd(parser);
+    parser->cursor = end == parser->end ? end : end + 1;
+    parser->lineStart = parser->cursor;
+    parser->line++;
+}
+
+/**
+ * @fn bool ageratum_yamlLineIsEmpty(const char *cursor, const char *lineEnd)
+ * @brief Check whether the rest of a line holds nothing but whitespace or a
+ * comment.
+ * @since v0.0.0.39
+ *
+ * @param[in] cursor The first character to check.
+ * @param[in] lineEnd The end of the line.
+ *
+ * @return Whether or not the rest of the line is empty.
+ */
+[[gnu::pure]]
+static bool ageratum_yamlLineIsEmpty(const char *cursor, const char *lineEnd)
+{
+    while (cursor < lineEnd && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    return cursor == lineEnd || *cursor == '#' || *cursor == '\r';
+}
+
+/**
+ * @fn bool ageratum_yamlSkipBlank(ageratum_yaml_parser_t *parser, size_t
+ * *indent)
+ * @brief Skip any blank lines, comments, and document markers from the start
+ * of the current line. The parser is left at the start of the next line with
+ * content, and repeated calls are harmless. Only a single "---" marker is
+ * accepted before the root, and no content may follow a "..." marker.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[out] indent The indentation of the line with content, or @c SIZE_MAX
+ * if the document has ended. Should content follow a "---" marker on the same
+ * line, this is the offset of that content instead.
+ *
+ * @return A boolean value representing whether or not the lines were valid.
+ */
+[[gnu::nonnull(1, 2)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlSkipBlank(ageratum_yaml_parser_t *parser,
+                                   size_t *indent)
+{
+    while (parser->cursor < parser->end)
+    {
+        const char *content = parser->cursor;
+        while (content < parser->end && *content == ' ') content++;
+        // Tabs may pad out a blank line, but never indent content.
+        const char *rest = content;
+        while (rest < parser->end && (*rest == ' ' || *rest == '\t')) rest++;
+        if (rest == parser->end) break;
+        if (*rest == '\n' || *rest == '\r' || *rest == '#')
+        {
+            ageratum_yamlNextLine(parser);
+            continue;
+        }
+        if (__builtin_expect(rest != content, 0))
+            return ageratum_yamlFail(parser, "tabs can't indent");
+
+        const bool marker =
+            content == parser->cursor && parser->end - content >= 3 &&
+            (__builtin_memcmp(content, "---", 3) == 0 ||
+             __builtin_memcmp(content, "...", 3) == 0) &&
+            (parser->end - content == 3 || content[3] == ' ' ||
+             content[3] == '\t' || content[3] == '\n' || content[3] == '\r');
+        if (__builtin_expect(parser->ended ||
+                                 (marker && *content == '-' &&
+                                  (parser->started || parser->marked)),
+                             0))
+            return ageratum_yamlFail(parser,
+                                     "multiple documents are unsupported");
+        if (!marker)
+        {
+            *indent = content - parser->cursor;
+            return true;
+        }
+
+        if (*content == '.') parser->ended = true;
+        else
+        {
+            parser->marked = true;
+            // The root may begin on the marker's own line.
+            const char *after = content + 3;
+            while (after < parser->end && (*after == ' ' || *after == '\t'))
+                after++;
+            if (!ageratum_yamlLineIsEmpty(after, ageratum_yamlLineEnd(parser)))
+            {
+                *indent = after - parser->cursor;
+                return true;
+            }
+        }
+        ageratum_yamlNextLine(parser);
+    }
+    parser->cursor = parser->end;
+    *indent = SIZE_MAX;
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlIsSeparator(const char *cursor, const char *end)
+ * @brief Check whether the given position separates an indicator from what
+ * follows it, being whitespace or the end of the input.
+ * @since v0.0.0.46
+ *
+ * @param[in] cursor The position to check.
+ * @param[in] end The end of the input or line.
+ *
+ * @return Whether or not the position is a separator.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static inline bool ageratum_yamlIsSeparator(const char *cursor,
+                                            const char *end)
+{
+    return cursor == end || *cursor == ' ' || *cursor == '\t' ||
+           *cursor == '\n' || *cursor == '\r';
+}
+
+/**
+ * @fn bool ageratum_yamlIsEntry(const ageratum_yaml_parser_t *const parser,
+ * const char *cursor)
+ * @brief Check whether the given position holds a block sequence entry.
+ * @since v0.0.0.39
+ *
+ * @param[in] parser The parser to be operated on.
+ * @param[in] cursor The position to check.
+ *
+ * @return Whether or not the position holds a "-" indicator.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static bool ageratum_yamlIsEntry(const ageratum_yaml_parser_t *const parser,
+                                 const char *cursor)
+{
+    return cursor < parser->end && *cursor == '-' &&
+           ageratum_yamlIsSeparator(cursor + 1, parser->end);
+}
+
+/**
+ * @fn const char *ageratum_yamlSkipQuoted(const char *cursor, const char
+ * *lineEnd)
+ * @brief Skip over a quoted scalar. The given position must be its opening
+ * quote.
+ * @since v0.0.0.39
+ *
+ * @param[in] cursor The opening quote.
+ * @param[in] lineEnd The end of the line.
+ *
+ * @return One past the closing quote, or @c nullptr if the scalar isn't
+ * closed on the same line.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static const char *ageratum_yamlSkipQuoted(const char *cursor,
+                                           const char *lineEnd)
+{
+    const char quote = *cursor++;
+    while (cursor < lineEnd)
+    {
+        if (quote == '"' && *cursor == '\\') cursor += 2;
+        else if (*cursor != quote) cursor++;
+        // Single quotes are escaped by doubling them.
+        else if (quote == '\'' && cursor + 1 < lineEnd && cursor[1] == '\'')
+            cursor += 2;
+        else return cursor + 1;
+    }
+    return nullptr;
+}
+
+/**
+ * @fn const char *ageratum_yamlFindColon(const char *cursor, const char
+ * *lineEnd)
+ * @brief Find the ":" indicator of a block map entry on the current line.
+ * @since v0.0.0.39
+ *
+ * @param[in] cursor The first character of the line's content.
+ * @param[in] lineEnd The end of the line.
+ *
+ * @return The indicator, or @c nullptr if the line isn't a map entry.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static const char *ageratum_yamlFindColon(const char *cursor,
+                                          const char *lineEnd)
+{
+    if (*cursor == '"' || *cursor == '\'')
+    {
+        cursor = ageratum_yamlSkipQuoted(cursor, lineEnd);
+        if (cursor == nullptr) return nullptr;
+        while (cursor < lineEnd && (*cursor == ' ' || *cursor == '\t'))
+            cursor++;
+        if (cursor == lineEnd || *cursor != ':') return nullptr;
+    }
+    else if (*cursor == '[' || *cursor == '{' || *cursor == '&' ||
+             *cursor == '*')
+        return nullptr;
+
+    for (char previous = 0; cursor < lineEnd; previous = *cursor++)
+    {
+        if (*cursor == '#' && (previous == ' ' || previous == '\t'))
+            return nullptr;
+        if (*cursor == ':' && ageratum_yamlIsSeparator(cursor + 1, lineEnd))
+            return cursor;
+    }
+    return nullptr;
+}
+
+/**
+ * @fn ageratum_yaml_view_t ageratum_yamlTrim(const char *start, const char
+ * *end)
+ * @brief Create a view of the given range, less any trailing whitespace.
+ * @since v0.0.0.39
+ *
+ * @param[in] start The first character of the range.
+ * @param[in] end One past the last character of the range.
+ *
+ * @return The trimmed view.
+ */
+[[gnu::nonnull(1, 2)]] [[gnu::pure]]
+static ageratum_yaml_view_t ageratum_yamlTrim(const char *start,
+                                              const char *end)
+{
+    while (end > start && (end[-1] == ' ' || end[-1] == '\t' ||
+                           end[-1] == '\r'))
+        end--;
+    return (ageratum_yaml_view_t){.data = start, .length = end - start};
+}
+
+/**
+ * @fn void ageratum_yamlSkipSpaces(ageratum_yaml_parser_t *parser, bool flow)
+ * @brief Skip whitespace, and within flow collections newlines and comments
+ * too.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] flow Whether or not the parser is within a flow collection.
+ */
+[[gnu::nonnull(1)]]
+static void ageratum_yamlSkipSpaces(ageratum_yaml_parser_t *parser, bool flow)
+{
+    while (parser->cursor < parser->end)
+    {
+        const char current = *parser->cursor;
+        if (current == ' ' || current == '\t' || current == '\r')
+            parser->cursor++;
+        else if (flow && (current == '\n' || current == '#'))
+            ageratum_yamlNextLine(parser);
+        else return;
+    }
+}
+
+/**
+ * @fn ageratum_yaml_view_t ageratum_yamlName(ageratum_yaml_parser_t *parser)
+ * @brief Parse the name of an anchor or alias. The parser must be at its "&"
+ * or "*" indicator.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ *
+ * @return The name, which is empty if none was given.
+ */
+[[gnu::nonnull(1)]]
+static ageratum_yaml_view_t ageratum_yamlName(ageratum_yaml_parser_t *parser)
+{
+    const char *start = ++parser->cursor;
+    while (parser->cursor < parser->end)
+    {
+        const char current = *parser->cursor;
+        if (current == ' ' || current == '\t' || current == '\r' ||
+            current == '\n' || current == ',' || current == '[' ||
+            current == ']' || current == '{' || current == '}')
+            break;
+        parser->cursor++;
+    }
+    return (ageratum_yaml_view_t){.data = start,
+                                  .length = parser->cursor - start};
+}
+
+/**
+ * @fn bool ageratum_yamlScalar(ageratum_yaml_parser_t *parser, bool flow,
+ * ageratum_yaml_view_t *view)
+ * @brief Parse a single-line quoted or plain scalar.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] flow Whether or not the parser is within a flow collection, where
+ * plain scalars also end at flow indicators.
+ * @param[out] view The text of the scalar.
+ *
+ * @return A boolean value representing whether or not the scalar was valid.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlScalar(ageratum_yaml_parser_t *parser, bool flow,
+                                ageratum_yaml_view_t *view)
+{
+    const char *lineEnd = ageratum_yamlLineEnd(parser);
+    const char *start = parser->cursor;
+    if (*start == '"' || *start == '\'')
+    {
+        const char *end = ageratum_yamlSkipQuoted(start, lineEnd);
+        if (__builtin_expect(end == nullptr, 0))
+            return ageratum_yamlFail(parser, "unterminated quoted scalar");
+        *view = (ageratum_yaml_view_t){.data = start + 1,
+                                       .length = end - start - 2};
+        parser->cursor = end;
+        return true;
+    }
+    if (__builtin_expect(*start == '|' || *start == '>', 0))
+        return ageratum_yamlFail(parser, "block scalars are unsupported");
+    if (__builtin_expect(*start == '!', 0))
+        return ageratum_yamlFail(parser, "tags are unsupported");
+
+    const char *cursor = start;
+    for (char previous = 0; cursor < lineEnd; previous = *cursor++)
+    {
+        const char current = *cursor;
+        if (current == '#' && (previous == ' ' || previous == '\t')) break;
+        if (!flow)
+        {
+            if (__builtin_expect(current == ':' && ageratum_yamlIsSeparator(
+                                                       cursor + 1, lineEnd),
+                                 0))
+                return ageratum_yamlFail(parser, "unexpected ':' in value");
+            continue;
+        }
+        if (current == ',' || current == '[' || current == ']' ||
+            current == '{' || current == '}')
+            break;
+        if (current == ':' &&
+            (ageratum_yamlIsSeparator(cursor + 1, lineEnd) ||
+             cursor[1] == ',' || cursor[1] == ']' || cursor[1] == '}'))
+            break;
+    }
+    *view = ageratum_yamlTrim(start, cursor);
+    parser->cursor = cursor;
+    if (__builtin_expect(view->length == 0, 0))
+        return ageratum_yamlFail(parser, "expected a value");
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlInline(ageratum_yaml_parser_t *parser, bool flow,
+ * uint32_t *index, size_t depth)
+ * @brief Parse a value which starts on the current line: a scalar, an alias,
+ * or a flow collection.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] flow Whether or not the parser is within a flow collection.
+ * @param[out] index The index of the parsed node.
+ * @param[in] depth The current nesting depth.
+ *
+ * @return A boolean value representing whether or not the value was valid.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlInline(ageratum_yaml_parser_t *parser, bool flow,
+                                uint32_t *index, size_t depth)
+{
+    if (__builtin_expect(parser->cursor == parser->end, 0))
+        return ageratum_yamlFail(parser, "expected a value");
+
+    const char current = *parser->cursor;
+    if (current == '[' || current == '{')
+        return ageratum_yamlFlow(parser, index, depth + 1);
+
+    if (current == '*')
+    {
+        const ageratum_yaml_view_t name = ageratum_yamlName(parser);
+        const ageratum_yaml_node_t *nodes = parser->document->nodes;
+        uint32_t target = parser->document->count;
+        // Search backwards, so redefined anchors resolve to the latest.
+        while (target-- > 0)
+            if (nodes[target].anchor.length == name.length &&
+                name.length != 0 &&
+                __builtin_memcmp(nodes[target].anchor.data, name.data,
+                                 name.length) == 0)
+                break;
+        if (__builtin_expect(target == UINT32_MAX, 0))
+            return ageratum_yamlFail(parser, "unknown anchor");
+        if (nodes[target].kind == AGERATUM_YAML_ALIAS)
+            target = nodes[target].child;
+
+        if (!ageratum_yamlAppend(parser, AGERATUM_YAML_ALIAS, index))
+            return false;
+        parser->document->nodes[*index].child = target;
+        parser->document->nodes[*index].value = name;
+        return true;
+    }
+
+    ageratum_yaml_view_t value;
+    if (!ageratum_yamlScalar(parser, flow, &value) ||
+        !ageratum_yamlAppend(parser, AGERATUM_YAML_SCALAR, index))
+        return false;
+    parser->document->nodes[*index].value = value;
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlValue(ageratum_yaml_parser_t *parser, size_t indent,
+ * bool entry, uint32_t *index, size_t depth)
+ * @brief Parse the value following a block map's ":" or a block sequence's
+ * "-" indicator. The value may be on the same line, nested on the lines
+ * after, or missing entirely.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] indent The indentation of the owning collection.
+ * @param[in] entry Whether or not the owning collection is a sequence.
+ * @param[out] index The index of the parsed node.
+ * @param[in] depth The current nesting depth.
+ *
+ * @return A boolean value representing whether or not the value was valid.
+ */
+[[gnu::nonnull(1, 4)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlValue(ageratum_yaml_parser_t *parser, size_t indent,
+                               bool entry, uint32_t *index, size_t depth)
+{
+    ageratum_yamlSkipSpaces(parser, false);
+    ageratum_yaml_view_t anchor = {0};
+    if (parser->cursor < parser->end && *parser->cursor == '&')
+    {
+        anchor = ageratum_yamlName(parser);
+        if (__builtin_expect(anchor.length == 0, 0))
+            return ageratum_yamlFail(parser, "expected an anchor name");
+        ageratum_yamlSkipSpaces(parser, false);
+    }
+
+    const char *lineEnd = ageratum_yamlLineEnd(parser);
+    if (ageratum_yamlLineIsEmpty(parser->cursor, lineEnd))
+    {
+        ageratum_yamlNextLine(parser);
+        size_t next;
+        if (!ageratum_yamlSkipBlank(parser, &next)) return false;
+
+        // A map's sequence may sit at the same indentation as its key.
+        if (next != SIZE_MAX &&
+            (next > indent ||
+             (!entry && next == indent &&
+              ageratum_yamlIsEntry(parser, parser->cursor + next))))
+        {
+            parser->cursor += next;
+            if (!ageratum_yamlBlock(parser, next, index, depth)) return false;
+        }
+        else if (!ageratum_yamlAppend(parser, AGERATUM_YAML_SCALAR, index))
+            return false;
+    }
+    // A sequence entry may open a compact collection on its own line.
+    else if (entry && (ageratum_yamlIsEntry(parser, parser->cursor) ||
+                       ageratum_yamlFindColon(parser->cursor, lineEnd)))
+    {
+        if (!ageratum_yamlBlock(parser, parser->cursor - parser->lineStart,
+                                index, depth))
+            return false;
+    }
+    else
+    {
+        if (!ageratum_yamlInline(parser, false, index, depth)) return false;
+        if (__builtin_expect(!ageratum_yamlLineIsEmpty(
+                                 parser->cursor, ageratum_yamlLineEnd(parser)),
+                             0))
+            return ageratum_yamlFail(parser, "unexpected text after value");
+        ageratum_yamlNextLine(parser);
+    }
+
+    parser->document->nodes[*index].anchor = anchor;
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlMap(ageratum_yaml_parser_t *parser, size_t indent,
+ * uint32_t *index, size_t depth)
+ * @brief Parse a block map. The parser must be at its first key.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] indent The indentation of the map's keys.
+ * @param[out] index The index of the parsed node.
+ * @param[in] depth The current nesting depth.
+ *
+ * @return A boolean value representing whether or not the map was valid.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlMap(ageratum_yaml_parser_t *parser, size_t indent,
+                             uint32_t *index, size_t depth)
+{
+    uint32_t map = 0, last = 0;
+    if (!ageratum_yamlAppend(parser, AGERATUM_YAML_MAP, &map)) return false;
+
+    for (;;)
+    {
+        const char *colon = ageratum_yamlFindColon(
+            parser->cursor, ageratum_yamlLineEnd(parser));
+        if (__builtin_expect(colon == nullptr, 0))
+            return ageratum_yamlFail(parser, "expected a key");
+
+        ageratum_yaml_view_t key;
+        if (*parser->cursor == '"' || *parser->cursor == '\'')
+        {
+            if (!ageratum_yamlScalar(parser, false, &key)) return false;
+        }
+        else key = ageratum_yamlTrim(parser->cursor, colon);
+        parser->cursor = colon + 1;
+
+        uint32_t value;
+        if (!ageratum_yamlValue(parser, indent, false, &value, depth + 1))
+            return false;
+        parser->document->nodes[value].key = key;
+        ageratum_yamlLink(parser->document, map, &last, value);
+
+        size_t next;
+        if (!ageratum_yamlSkipBlank(parser, &next)) return false;
+        if (next == SIZE_MAX || next < indent ||
+            ageratum_yamlIsEntry(parser, parser->cursor + next))
+            break;
+        if (__builtin_expect(next > indent, 0))
+            return ageratum_yamlFail(parser, "unexpected indentation");
+        parser->cursor += next;
+    }
+
+    *index = map;
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlSequence(ageratum_yaml_parser_t *parser, size_t
+ * indent, uint32_t *index, size_t depth)
+ * @brief Parse a block sequence. The parser must be at its first "-"
+ * indicator.
+ * @since v0.0.0.39
+ *
+ * @param[in, out] parser The parser to be operated on.
+ * @param[in] indent The indentation of the sequence's indicators.
+ * @param[out] index The index of the parsed node.
+ * @param[in] depth The current nesting depth.
+ *
+ * @return A boolean value representing whether or not the sequence was valid.
+ */
+[[gnu::nonnull(1, 3)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlSequence(ageratum_yaml_parser_t *parser,
+                                  size_t indent, uint32_t *index, size_t depth)
+{
+    uint32_t sequence = 0, last = 0;
+    if (!ageratum_yamlAppend(parser, AGERATUM_YAML_SEQUENCE, &sequence))
+        return false;
+
+    for (;;)
+    {
+        parser->cursor++;
+        uint32_t item;
+        if (!ageratum_yamlValue(parser, indent, true, &item, depth + 1))
+            return false;
+        ageratum_yamlLink(parser->document, sequence, &last, item);
+
+        size_t next;
+        if (!ageratum_yamlSkipBlank(parser, &next)) return false;
+        if (next == SIZE_MAX || next < indent) break;
+        if (__builtin_expect(next > indent, 0))
+            return ageratum_yamlFail(parser, "unexpected indentation");
+        // A map's sequence can end at a key of the same indentation.
+        if (!ageratum_yamlIsEntry(parser, parser->cursor + next)) break;
+        parser->cursor += next;
+    }
+
+    *index = sequence;
+    return true;
+}
+
+static bool ageratum_yamlBlock(ageratum_yaml_parser_t *parser, size_t indent,
+                               uint32_t *index, size_t depth)
+{
+    if (__builtin_expect(depth > AGERATUM_YAML_MAX_DEPTH, 0))
+        return ageratum_yamlFail(parser, "nesting too deep");
+
+    if (ageratum_yamlIsEntry(parser, parser->cursor))
+        return ageratum_yamlSequence(parser, indent, index, depth);
+    if (ageratum_yamlFindColon(parser->cursor, ageratum_yamlLineEnd(parser)))
+        return ageratum_yamlMap(parser, indent, index, depth);
+
+    if (!ageratum_yamlInline(parser, false, index, depth)) return false;
+    if (__builtin_expect(!ageratum_yamlLineIsEmpty(
+                             parser->cursor, ageratum_yamlLineEnd(parser)),
+                         0))
+        return ageratum_yamlFail(parser, "unexpected text after value");
+    ageratum_yamlNextLine(parser);
+    return true;
+}
+
+static bool ageratum_yamlFlow(ageratum_yaml_parser_t *parser, uint32_t *index,
+                              size_t depth)
+{
+    if (__builtin_expect(depth > AGERATUM_YAML_MAX_DEPTH, 0))
+        return ageratum_yamlFail(parser, "nesting too deep");
+
+    const bool isMap = *parser->cursor++ == '{';
+    const char close = isMap ? '}' : ']';
+    uint32_t collection = 0, last = 0;
+    if (!ageratum_yamlAppend(
+            parser, isMap ? AGERATUM_YAML_MAP : AGERATUM_YAML_SEQUENCE,
+            &collection))
+        return false;
+
+    for (;;)
+    {
+        ageratum_yamlSkipSpaces(parser, true);
+        if (__builtin_expect(parser->cursor == parser->end, 0))
+            return ageratum_yamlFail(parser, "unterminated flow collection");
+        if (*parser->cursor == close)
+        {
+            parser->cursor++;
+            break;
+        }
+
+        ageratum_yaml_view_t key = {0};
+        if (isMap)
+        {
+            if (!ageratum_yamlScalar(parser, true, &key)) return false;
+            ageratum_yamlSkipSpaces(parser, true);
+            if (__builtin_expect(
+                    parser->cursor == parser->end || *parser->cursor != ':', 0))
+                return ageratum_yamlFail(parser, "expected ':'");
+            parser->cursor++;
+            ageratum_yamlSkipSpaces(parser, true);
+        }
+
+        ageratum_yaml_view_t anchor = {0};
+        if (parser->cursor < parser->end && *parser->cursor == '&')
+        {
+            anchor = ageratum_yamlName(parser);
+            if (__builtin_expect(anchor.length == 0, 0))
+                return ageratum_yamlFail(parser, "expected an anchor name");
+            ageratum_yamlSkipSpaces(parser, true);
+        }
+
+        uint32_t item;
+        // A flow map's value may be left out entirely, leaving it empty.
+        if (isMap && parser->cursor < parser->end &&
+            (*parser->cursor == ',' || *parser->cursor == close))
+        {
+            if (!ageratum_yamlAppend(parser, AGERATUM_YAML_SCALAR, &item))
+                return false;
+        }
+        else if (!ageratum_yamlInline(parser, true, &item, depth))
+            return false;
+        parser->document->nodes[item].key = key;
+        parser->document->nodes[item].anchor = anchor;
+        ageratum_yamlLink(parser->document, collection, &last, item);
+
+        ageratum_yamlSkipSpaces(parser, true);
+        if (parser->cursor < parser->end && *parser->cursor == ',')
+            parser->cursor++;
+        else if (__builtin_expect(parser->cursor == parser->end ||
+                                      *parser->cursor != close,
+                                  0))
+            return ageratum_yamlFail(parser, "expected ',' or a closing "
+                                             "bracket");
+    }
+
+    *index = collection;
+    return true;
+}
+
+/**
+ * @fn bool ageratum_yamlRoot(ageratum_yaml_parser_t *parser)
+ * @brief Parse an entire source into the parser's document, which must be
+ * empty.
+ * @since v0.0.0.48
+ *
+ * @param[in, out] parser The parser to be operated on, at the start of the
+ * source.
+ *
+ * @return A boolean value representing whether or not the source was valid.
+ */
+[[gnu::nonnull(1)]] [[nodiscard("Expression result unchecked.")]]
+static bool ageratum_yamlRoot(ageratum_yaml_parser_t *parser)
+{
+    size_t indent;
+    uint32_t root;
+    if (!ageratum_yamlSkipBlank(parser, &indent)) return false;
+    parser->started = true;
+    if (indent == SIZE_MAX)
+        return ageratum_yamlAppend(parser, AGERATUM_YAML_SCALAR, &root);
+
+    parser->cursor += indent;
+    if (!ageratum_yamlBlock(parser, indent, &root, 0) ||
+        !ageratum_yamlSkipBlank(parser, &indent))
+        return false;
+    if (__builtin_expect(indent != SIZE_MAX, 0))
+        return ageratum_yamlFail(parser, "unexpected text after root");
+    return true;
+}
+
+bool ageratum_parseYAML(ageratum_yaml_document_t *document,
+                        const char *const source, size_t size)
+{
+    const uint32_t checksum = ageratum_crc32c(0, source, size);
+    if (document->count != 0 && document->size == size &&
+        document->checksum == checksum)
+    {
+        // Nothing changed but, possibly, where the contents live.
+        const uintptr_t from = (uintptr_t)document->source;
+        for (uint32_t i = 0; i < document->count && source != document->source;
+             i++)
+        {
+            ageratum_yaml_node_t *node = &document->nodes[i];
+            ageratum_yaml_view_t *views[3] = {&node->key, &node->value,
+                                              &node->anchor};
+            for (size_t j = 0; j < 3; j++)
+                if (views[j]->data != nullptr)
+                    views[j]->data =
+                        source + ((uintptr_t)views[j]->data - from);
+        }
+        document->source = source;
+        primrose_log(VERBOSE_OK, "YAML document unchanged, skipped reparse.");
+        return true;
+    }
+
+    // Parse after the current nodes, so a failure leaves them untouched. Node
+    // indices are relative to the scratch document, so they survive the move.
+    ageratum_yaml_document_t scratch = {
+        .nodes = document->nodes + document->count,
+        .capacity = document->capacity - document->count};
+    ageratum_yaml_parser_t parser = {.document = &scratch,
+                                     .cursor = source,
+                                     .lineStart = source,
+                                     .end = source + size,
+                                     .line = 1,
+                                     .spare = document->count != 0};
+    bool parsed = ageratum_yamlRoot(&parser);
+    if (!parsed && parser.exhausted)
+    {
+        primrose_log(WARNING, "Too few spare YAML nodes, reparsing in place.");
+        document->count = 0;
+        scratch = (ageratum_yaml_document_t){.nodes = document->nodes,
+                                             .capacity = document->capacity};
+        parser = (ageratum_yaml_parser_t){.document = &scratch,
+                                          .cursor = source,
+                                          .lineStart = source,
+                                          .end = source + size,
+                                          .line = 1};
+        parsed = ageratum_yamlRoot(&parser);
+    }
+    if (!parsed) return false;
+
+    if (scratch.nodes != document->nodes)
+        __builtin_memmove(document->nodes, scratch.nodes,
+                          scratch.count * sizeof(ageratum_yaml_node_t));
+    document->count = scratch.count;
+    document->source = source;
+    document->size = size;
+    document->checksum = checksum;
+    primrose_log(VERBOSE_OK, "Parsed YAML document into %u nodes.",
+                 document->count);
+    return true;
+}
+
+uint32_t ageratum_findYAML(const ageratum_yaml_document_t *const document,
+                           uint32_t map, const char *const key)
+{
+    const ageratum_yaml_node_t *nodes = document->nodes;
+    if (nodes[map].kind == AGERATUM_YAML_ALIAS) map = nodes[map].child;
+    if (nodes[map].kind != AGERATUM_YAML_MAP) return 0;
+
+    size_t length = 0;
+    while (key[length] != 0) length++;
+    for (uint32_t child = nodes[map].child; child != 0;
+         child = nodes[child].next)
+    {
+        if (nodes[child].key.length != length ||
+            __builtin_memcmp(nodes[child].key.data, key, length) != 0)
+            continue;
+        return nodes[child].kind == AGERATUM_YAML_ALIAS ? nodes[child].child
+                                                        : child;
     }
+    return 0;
 }
 
 #endif // AGERATUM_IMPLEMENTATION